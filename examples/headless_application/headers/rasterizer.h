@@ -0,0 +1,99 @@
+#ifndef RASTERIZER_H
+#define RASTERIZER_H
+
+#include "microui.h"
+#include "sdf_font.h"
+
+typedef struct Rasterizer Rasterizer;
+
+/* Framebuffer tiles are hashed and repainted in squares of this many pixels */
+enum { RASTERIZER_TILE = 32 };
+
+/* Font handle: size 0 blits the bitmap atlas as is, any other size is drawn
+** from the distance field scaled to that many pixels high */
+typedef struct RasterizerFont {
+  Rasterizer *rasterizer;
+  float size;
+} RasterizerFont;
+
+/* A command and the screen area it can write, after clipping */
+typedef struct RasterizerItem {
+  mu_Command *command;
+  mu_Rectangle bounds;
+  const mu_Container *root;
+  int profiled; /* already counted in this frame's profile */
+} RasterizerItem;
+
+/* Diagnostics gathered while profiling: where raster time and overdraw go */
+typedef struct RasterizerProfile {
+  unsigned short *overdraw; /* per pixel, how many commands wrote to it */
+  long written;             /* pixel writes counted so far */
+  int type_count[MU_COMMAND_MAX];
+  long type_pixels[MU_COMMAND_MAX];
+  double type_seconds[MU_COMMAND_MAX];
+  const mu_Container *roots[MU_ROOTLIST_SIZE];
+  mu_Rectangle root_rects[MU_ROOTLIST_SIZE];
+  int root_count[MU_ROOTLIST_SIZE];
+  long root_pixels[MU_ROOTLIST_SIZE];
+  double root_seconds[MU_ROOTLIST_SIZE];
+  int root_total;
+} RasterizerProfile;
+
+struct Rasterizer {
+  int width;
+  int height;
+  mu_Color *pixels;
+  mu_Rectangle clip;
+  mu_Rectangle scissor; /* bounds every clip rect: the region being repainted */
+  SdfFont *sdf;
+  RasterizerFont font; /* default bitmap font */
+  /* incremental repaint: per tile, a hash of the commands that touch it */
+  int tiles_x;
+  int tiles_y;
+  unsigned long long *tile_hashes;
+  unsigned long long *next_hashes;
+  unsigned char *dirty_tiles;
+  int repaint_all;
+  int frame;
+  RasterizerItem *items;
+  int item_capacity;
+  /* regions repainted by the last rasterizer_render, for presentation */
+  mu_Rectangle *dirty;
+  int dirty_count;
+  RasterizerProfile *profile; /* NULL unless profiling */
+};
+
+/* App-owned RGBA pixels, read in place at draw time */
+typedef struct RasterizerImage {
+  int width;
+  int height;
+  const mu_Color *pixels;
+  int version; /* bump after changing pixels so tiles showing them repaint */
+} RasterizerImage;
+
+Rasterizer *rasterizer_init(int width, int height);
+void rasterizer_destroy(Rasterizer *rasterizer);
+void rasterizer_draw_rect(Rasterizer *rasterizer, mu_Rectangle rectangle, mu_Color color);
+void rasterizer_draw_lines(Rasterizer *rasterizer, const mu_Vector2 *points, int count, mu_Color color);
+void rasterizer_draw_text(Rasterizer *rasterizer, const RasterizerFont *font, const char *text, mu_Vector2 position, mu_Color color);
+void rasterizer_draw_icon(Rasterizer *rasterizer, int identifier, mu_Rectangle rectangle, mu_Color color);
+void rasterizer_draw_image(Rasterizer *rasterizer, const RasterizerImage *image, mu_Rectangle source, mu_Rectangle rectangle, mu_Color color);
+void rasterizer_draw_callback(Rasterizer *rasterizer, mu_DrawCallback callback, mu_Rectangle rectangle, void *user_data);
+int rasterizer_get_text_width(const RasterizerFont *font, const char *text, int length);
+int rasterizer_get_text_height(const RasterizerFont *font);
+void rasterizer_set_clip_rect(Rasterizer *rasterizer, mu_Rectangle rectangle);
+void rasterizer_clear(Rasterizer *rasterizer, mu_Color color);
+/* draw the context's commands over a framebuffer kept from the last call,
+** re-rasterizing only tiles whose commands changed; returns dirty_count */
+int rasterizer_render(Rasterizer *rasterizer, mu_Context *context, mu_Color background);
+/* make the next rasterizer_render repaint everything */
+void rasterizer_invalidate(Rasterizer *rasterizer);
+/* start gathering a fresh RasterizerProfile from the commands drawn by
+** rasterizer_render, or stop and drop it */
+void rasterizer_profile(Rasterizer *rasterizer, int enabled);
+/* overdraw heatmap over a dimmed frame as PPM, and time and pixels per
+** command type and per root container as CSV */
+int rasterizer_write_profile(Rasterizer *rasterizer, const char *image_path, const char *csv_path);
+int rasterizer_write_ppm(Rasterizer *rasterizer, const char *path);
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef SDF_FONT_H
+#define SDF_FONT_H
+
+#include "microui.h"
+
+/* Signed distance field of the atlas.inl glyphs, built once at startup.
+** Any text size is drawn from the same field by resampling it and turning
+** distance into coverage, and widths come from scaling the advance table,
+** so changing size never re-rasterizes anything. */
+
+enum
+{
+  SDF_SPREAD = 4, /* distance range in source texels, also the glyph padding */
+  SDF_GLYPHS = 128
+};
+
+typedef struct SdfGlyph {
+  int offset; /* first texel in SdfFont.field */
+  int width;  /* padded size in texels */
+  int height;
+  int advance; /* in source texels */
+} SdfGlyph;
+
+typedef struct SdfFont {
+  unsigned char *field; /* 128 = edge, higher is inside */
+  SdfGlyph glyphs[SDF_GLYPHS];
+  int height; /* native line height in texels */
+} SdfFont;
+
+SdfFont *sdf_font_create(void);
+void sdf_font_destroy(SdfFont *font);
+/* width of text drawn at `size` pixels high, from the scaled advance table */
+int sdf_font_text_width(const SdfFont *font, const char *text, int length, float size);
+/* draw into an RGBA framebuffer row-major with `stride` pixels per row, limited to clip;
+** if `counts` is given (same layout), bumps it for each pixel written and
+** returns how many were */
+int sdf_font_draw(const SdfFont *font, mu_Color *pixels, int stride, mu_Rectangle clip,
+                  const char *text, mu_Vector2 position, float size, mu_Color color, unsigned short *counts);
+
+#endif
@@ -0,0 +1,283 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rasterizer.h"
+#include "microui.h"
+#include "microui_chart.h"
+#include "microui_histogram.h"
+#include "microui_sparkline.h"
+
+static float samples[1 << 16];
+static mu_Series series;
+static mu_Chart chart;
+static mu_Histogram latency;
+
+enum
+{
+  HOST_COUNT = 5000,
+  HOST_SAMPLES = 120
+};
+static char host_names[HOST_COUNT][16];
+static float host_cpu[HOST_COUNT][HOST_SAMPLES];
+static float host_net[HOST_COUNT][HOST_SAMPLES];
+static mu_Vector2 cpu_points[64 * 48];
+static mu_Vector2 net_points[64 * 48];
+
+enum
+{
+  HEATMAP_WIDTH = 64,
+  HEATMAP_HEIGHT = 32
+};
+static mu_Color heatmap_pixels[HEATMAP_WIDTH * HEATMAP_HEIGHT];
+static RasterizerImage heatmap = {.width = HEATMAP_WIDTH, .height = HEATMAP_HEIGHT, .pixels = heatmap_pixels};
+
+static void chart_window(mu_Context *context)
+{
+  if (mu_begin_window(context, "Chart", mu_rect(40, 40, 520, 260)))
+  {
+    char buffer[64];
+    mu_layout_row(context, 2, (int[]){80, -1}, 0);
+    mu_label(context, "Samples:");
+    sprintf(buffer, "%d", series.count);
+    mu_label(context, buffer);
+    mu_layout_row(context, 1, (int[]){-1}, -1);
+    mu_chart_ex(context, &chart, &series, mu_color(90, 200, 120, 255), MU_CHART_AUTOSCALE);
+    mu_end_window(context);
+  }
+}
+
+static void draw_rings(void *handle, mu_Rectangle rectangle, void *user_data)
+{
+  /* app-rendered content: a per-pixel pattern written straight into the
+  ** framebuffer, limited to the active clip */
+  Rasterizer *rasterizer = handle;
+  const mu_Color *tint = user_data;
+  int cx = rectangle.x + rectangle.w / 2, cy = rectangle.y + rectangle.h / 2;
+  int x1 = mu_max(rectangle.x, rasterizer->clip.x);
+  int y1 = mu_max(rectangle.y, rasterizer->clip.y);
+  int x2 = mu_min(rectangle.x + rectangle.w, rasterizer->clip.x + rasterizer->clip.w);
+  int y2 = mu_min(rectangle.y + rectangle.h, rasterizer->clip.y + rasterizer->clip.h);
+  for (int y = y1; y < y2; y++)
+  {
+    for (int x = x1; x < x2; x++)
+    {
+      int d = (int)sqrtf((float)((x - cx) * (x - cx) + (y - cy) * (y - cy)));
+      if ((d / 6) & 1)
+        rasterizer->pixels[y * rasterizer->width + x] = *tint;
+    }
+  }
+}
+
+static void info_window(mu_Context *context)
+{
+  if (mu_begin_window(context, "Info", mu_rect(40, 320, 520, 160)))
+  {
+    mu_layout_row(context, 1, (int[]){-1}, 0);
+    mu_label(context, "Rendered without a display by the software rasterizer.");
+    mu_layout_row(context, 3, (int[]){100, 100, -1}, 0);
+    mu_button(context, "Button 1");
+    mu_button(context, "Button 2");
+    static int check = 1;
+    mu_checkbox(context, "Checkbox", &check);
+    mu_layout_row(context, 2, (int[]){-80, -1}, -1);
+    mu_image(context, (mu_Texture)&heatmap, mu_rect(0, 0, HEATMAP_WIDTH, HEATMAP_HEIGHT));
+    static mu_Color ring_color = {230, 200, 90, 255};
+    mu_draw_callback(context, mu_layout_next(context), draw_rings, &ring_color);
+    mu_end_window(context);
+  }
+}
+
+static RasterizerFont text_sizes[] = {{NULL, 11}, {NULL, 18}, {NULL, 27}, {NULL, 40}};
+
+static void text_window(mu_Context *context)
+{
+  if (mu_begin_window(context, "Text", mu_rect(40, 500, 520, 220)))
+  {
+    /* every size is drawn from the same distance field */
+    mu_Font font = context->style->font;
+    for (int i = 0; i < (int)(sizeof(text_sizes) / sizeof(*text_sizes)); i++)
+    {
+      context->style->font = (mu_Font)&text_sizes[i];
+      mu_layout_row(context, 1, (int[]){-1}, rasterizer_get_text_height(&text_sizes[i]) + 4);
+      mu_label(context, "Scaled SDF text, 0123456789");
+    }
+    context->style->font = font;
+    mu_end_window(context);
+  }
+}
+
+static void latency_window(mu_Context *context)
+{
+  if (mu_begin_window(context, "Latency", mu_rect(40, 740, 520, 200)))
+  {
+    char buffer[64];
+    mu_layout_row(context, 1, (int[]){-1}, 0);
+    sprintf(buffer, "%.0f samples, %.3g..%.3g ms (log bins)", latency.total, latency.low, latency.high);
+    mu_label(context, buffer);
+    mu_layout_row(context, 1, (int[]){-1}, -1);
+    mu_histogram_ex(context, &latency, mu_color(230, 150, 80, 255), 0);
+    mu_end_window(context);
+  }
+}
+
+static void hosts_window(mu_Context *context)
+{
+  if (mu_begin_window(context, "Hosts", mu_rect(580, 40, 380, 900)))
+  {
+    mu_Sparklines cpu, net;
+    mu_layout_row(context, 3, (int[]){90, 140, -1}, 0);
+    mu_label(context, "host");
+    mu_label(context, "cpu %");
+    mu_label(context, "net MB/s");
+
+    /* one lines command per column for all visible rows */
+    mu_sparklines_begin(context, &cpu, cpu_points, sizeof(cpu_points) / sizeof(*cpu_points), 48,
+                        mu_color(120, 200, 120, 255));
+    mu_sparklines_begin(context, &net, net_points, sizeof(net_points) / sizeof(*net_points), 48,
+                        mu_color(110, 160, 230, 255));
+    mu_layout_row(context, 3, (int[]){90, 140, -1}, 18);
+    for (int i = 0; i < HOST_COUNT; i++)
+    {
+      mu_label(context, host_names[i]);
+      mu_sparkline_ex(context, &cpu, host_cpu[i], HOST_SAMPLES, 0, 100, MU_OPT_NOFRAME);
+      mu_sparkline(context, &net, host_net[i], HOST_SAMPLES);
+    }
+    mu_sparklines_end(context, &cpu);
+    mu_sparklines_end(context, &net);
+    mu_end_window(context);
+  }
+}
+
+static void process_frame(mu_Context *context)
+{
+  mu_begin(context);
+  chart_window(context);
+  info_window(context);
+  text_window(context);
+  latency_window(context);
+  hosts_window(context);
+  mu_end(context);
+}
+
+static int text_width(mu_Font font, const char *text, int length)
+{
+  RasterizerFont *rasterizer_font = (RasterizerFont *)font;
+  if (length == -1)
+  {
+    length = strlen(text);
+  }
+  return rasterizer_get_text_width(rasterizer_font, text, length);
+}
+
+static int text_height(mu_Font font)
+{
+  return rasterizer_get_text_height((RasterizerFont *)font);
+}
+
+int main(int argc, char **argv)
+{
+  const char *output = argc > 1 ? argv[1] : "frame.ppm";
+  /* optional: profile the last frame into <prefix>.ppm and <prefix>.csv */
+  const char *profile = argc > 2 ? argv[2] : NULL;
+
+  /* init rasterizer */
+  Rasterizer *rasterizer = rasterizer_init(1000, 960);
+
+  /* init microui */
+  mu_Context *context = malloc(sizeof(mu_Context));
+  mu_init(context);
+  context->text_width = text_width;
+  context->text_height = text_height;
+  /* Use the rasterizer's bitmap font as the default font handle */
+  context->style->font = (mu_Font)&rasterizer->font;
+  for (int i = 0; i < (int)(sizeof(text_sizes) / sizeof(*text_sizes)); i++)
+  {
+    text_sizes[i].rasterizer = rasterizer;
+  }
+
+  /* fill the series with a long noisy signal */
+  mu_series_init(&series, samples, sizeof(samples) / sizeof(*samples));
+  mu_chart_init(&chart, -1, 1);
+  for (int i = 0; i < 1000000; i++)
+  {
+    float value = sinf(i * 0.0002f) + 0.2f * sinf(i * 0.05f) + ((rand() % 1000) - 500) * 0.0002f;
+    mu_series_push(&series, &value, 1);
+  }
+
+  /* latency-like samples binned batch by batch; only the bins are kept */
+  mu_histogram_init(&latency, 0.1f, 10, 96, MU_HISTOGRAM_LOG | MU_HISTOGRAM_AUTORANGE);
+  for (int batch = 0; batch < 100; batch++)
+  {
+    float values[4096];
+    for (int i = 0; i < 4096; i++)
+    {
+      float u = (rand() + 1.0f) / RAND_MAX;
+      values[i] = expf(0.8f * sqrtf(-2 * logf(u)) * cosf(6.2831853f * rand() / RAND_MAX)) * (rand() % 20 ? 1 : 8);
+    }
+    mu_histogram_push(&latency, values, 4096);
+  }
+
+  /* per-host metric history */
+  for (int i = 0; i < HOST_COUNT; i++)
+  {
+    float load = rand() % 60, phase = rand() % 100;
+    sprintf(host_names[i], "web-%04d", i);
+    for (int j = 0; j < HOST_SAMPLES; j++)
+    {
+      host_cpu[i][j] = load + 20 * sinf((j + phase) * 0.1f) + rand() % 15;
+      host_net[i][j] = (rand() % 40 ? 1 : 6) * (2 + sinf((j + phase) * 0.05f) + (rand() % 100) * 0.01f);
+    }
+  }
+
+  /* heatmap of a 2D function */
+  for (int y = 0; y < HEATMAP_HEIGHT; y++)
+  {
+    for (int x = 0; x < HEATMAP_WIDTH; x++)
+    {
+      int v = (int)(127.5f + 127.5f * sinf(x * 0.2f) * cosf(y * 0.3f));
+      heatmap_pixels[y * HEATMAP_WIDTH + x] = mu_color(v, 64, 255 - v, 255);
+    }
+  }
+
+  /* a couple of frames so windows settle, then write the last one; after
+  ** the first, only tiles whose commands changed are rasterized again */
+  for (int frame = 0; frame < 3; frame++)
+  {
+    process_frame(context);
+    if (profile && frame == 2)
+    {
+      /* a full repaint, so the counts cover every window */
+      rasterizer_profile(rasterizer, 1);
+      rasterizer_invalidate(rasterizer);
+    }
+    int regions = rasterizer_render(rasterizer, context, mu_color(90, 95, 100, 255));
+    long pixels = 0;
+    for (int i = 0; i < regions; i++)
+    {
+      pixels += (long)rasterizer->dirty[i].w * rasterizer->dirty[i].h;
+    }
+    printf("Frame %d: %d dirty regions, %ld pixels\n", frame, regions, pixels);
+  }
+
+  int ok = rasterizer_write_ppm(rasterizer, output);
+  if (ok)
+  {
+    printf("Wrote %s\n", output);
+  }
+  if (ok && profile)
+  {
+    char image_path[256], csv_path[256];
+    snprintf(image_path, sizeof(image_path), "%s.ppm", profile);
+    snprintf(csv_path, sizeof(csv_path), "%s.csv", profile);
+    ok = rasterizer_write_profile(rasterizer, image_path, csv_path);
+    if (ok)
+    {
+      printf("Wrote %s and %s\n", image_path, csv_path);
+    }
+  }
+
+  free(context);
+  rasterizer_destroy(rasterizer);
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,725 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rasterizer.h"
+#include "atlas_font.h"
+
+static mu_Rectangle intersect(mu_Rectangle a, mu_Rectangle b)
+{
+  int x1 = mu_max(a.x, b.x);
+  int y1 = mu_max(a.y, b.y);
+  int x2 = mu_min(a.x + a.w, b.x + b.w);
+  int y2 = mu_min(a.y + a.h, b.y + b.h);
+  return mu_rect(x1, y1, mu_max(x2 - x1, 0), mu_max(y2 - y1, 0));
+}
+
+static void blend(mu_Color *dst, mu_Color src, int alpha)
+{
+  if (alpha >= 255)
+  {
+    *dst = src;
+    return;
+  }
+  dst->red = (src.red * alpha + dst->red * (255 - alpha)) / 255;
+  dst->green = (src.green * alpha + dst->green * (255 - alpha)) / 255;
+  dst->blue = (src.blue * alpha + dst->blue * (255 - alpha)) / 255;
+}
+
+/* while profiling, note that one more command wrote the pixel at `index` */
+static void count_write(Rasterizer *rasterizer, int index)
+{
+  RasterizerProfile *profile = rasterizer->profile;
+  profile->overdraw[index] += profile->overdraw[index] < 0xffff;
+  profile->written++;
+}
+
+/* draw an alpha-only atlas region at (x, y), modulated by color */
+static void blit(Rasterizer *rasterizer, mu_Rectangle src, int x, int y, mu_Color color)
+{
+  mu_Rectangle dst = intersect(mu_rect(x, y, src.w, src.h), rasterizer->clip);
+  for (int j = dst.y; j < dst.y + dst.h; j++)
+  {
+    const unsigned char *row = atlas_texture + (src.y + j - y) * ATLAS_WIDTH + src.x - x;
+    mu_Color *out = rasterizer->pixels + j * rasterizer->width;
+    for (int i = dst.x; i < dst.x + dst.w; i++)
+    {
+      int alpha = row[i] * color.alpha / 255;
+      if (alpha)
+      {
+        blend(&out[i], color, alpha);
+        if (rasterizer->profile)
+          count_write(rasterizer, j * rasterizer->width + i);
+      }
+    }
+  }
+}
+
+Rasterizer *rasterizer_init(int width, int height)
+{
+  Rasterizer *rasterizer = malloc(sizeof(Rasterizer));
+  if (!rasterizer)
+  {
+    fprintf(stderr, "Failed to allocate Rasterizer\n");
+    exit(1);
+  }
+
+  rasterizer->width = width;
+  rasterizer->height = height;
+  rasterizer->pixels = calloc((size_t)width * height, sizeof(mu_Color));
+  if (!rasterizer->pixels)
+  {
+    fprintf(stderr, "Failed to allocate %dx%d framebuffer\n", width, height);
+    free(rasterizer);
+    exit(1);
+  }
+  rasterizer->clip = mu_rect(0, 0, width, height);
+  rasterizer->scissor = rasterizer->clip;
+  rasterizer->tiles_x = (width + RASTERIZER_TILE - 1) / RASTERIZER_TILE;
+  rasterizer->tiles_y = (height + RASTERIZER_TILE - 1) / RASTERIZER_TILE;
+  int tiles = rasterizer->tiles_x * rasterizer->tiles_y;
+  rasterizer->tile_hashes = calloc(tiles, sizeof(unsigned long long));
+  rasterizer->next_hashes = calloc(tiles, sizeof(unsigned long long));
+  rasterizer->dirty_tiles = calloc(tiles, 1);
+  rasterizer->dirty = calloc(tiles, sizeof(mu_Rectangle));
+  if (!rasterizer->tile_hashes || !rasterizer->next_hashes || !rasterizer->dirty_tiles || !rasterizer->dirty)
+  {
+    fprintf(stderr, "Failed to allocate %dx%d tiles\n", rasterizer->tiles_x, rasterizer->tiles_y);
+    exit(1);
+  }
+  rasterizer->repaint_all = 1;
+  rasterizer->frame = 0;
+  rasterizer->items = NULL;
+  rasterizer->item_capacity = 0;
+  rasterizer->dirty_count = 0;
+  rasterizer->profile = NULL;
+  rasterizer->sdf = sdf_font_create();
+  if (!rasterizer->sdf)
+  {
+    fprintf(stderr, "Failed to build SDF font\n");
+    free(rasterizer->pixels);
+    free(rasterizer);
+    exit(1);
+  }
+  rasterizer->font = (RasterizerFont){rasterizer, 0};
+  return rasterizer;
+}
+
+void rasterizer_destroy(Rasterizer *rasterizer)
+{
+  if (!rasterizer)
+    return;
+
+  rasterizer_profile(rasterizer, 0);
+  sdf_font_destroy(rasterizer->sdf);
+  free(rasterizer->tile_hashes);
+  free(rasterizer->next_hashes);
+  free(rasterizer->dirty_tiles);
+  free(rasterizer->dirty);
+  free(rasterizer->items);
+  free(rasterizer->pixels);
+  free(rasterizer);
+}
+
+void rasterizer_draw_rect(Rasterizer *rasterizer, mu_Rectangle rectangle, mu_Color color)
+{
+  mu_Rectangle dst = intersect(rectangle, rasterizer->clip);
+  for (int j = dst.y; j < dst.y + dst.h; j++)
+  {
+    mu_Color *out = rasterizer->pixels + j * rasterizer->width;
+    for (int i = dst.x; i < dst.x + dst.w; i++)
+    {
+      blend(&out[i], color, color.alpha);
+    }
+  }
+}
+
+/* Liang-Barsky: clip segment p0-p1 to the clip rect, returns 0 if outside */
+static int clip_segment(mu_Rectangle clip, double *x0, double *y0, double *x1, double *y1)
+{
+  double t0 = 0, t1 = 1;
+  double dx = *x1 - *x0, dy = *y1 - *y0;
+  double p[4] = {-dx, dx, -dy, dy};
+  double q[4] = {*x0 - clip.x, clip.x + clip.w - 1 - *x0, *y0 - clip.y, clip.y + clip.h - 1 - *y0};
+  for (int i = 0; i < 4; i++)
+  {
+    if (p[i] == 0)
+    {
+      if (q[i] < 0)
+        return 0;
+      continue;
+    }
+    double t = q[i] / p[i];
+    if (p[i] < 0)
+      t0 = mu_max(t0, t);
+    else
+      t1 = mu_min(t1, t);
+  }
+  if (t0 > t1)
+    return 0;
+  *x1 = *x0 + t1 * dx;
+  *y1 = *y0 + t1 * dy;
+  *x0 = *x0 + t0 * dx;
+  *y0 = *y0 + t0 * dy;
+  return 1;
+}
+
+void rasterizer_draw_lines(Rasterizer *rasterizer, const mu_Vector2 *points, int count, mu_Color color)
+{
+  mu_Rectangle clip = rasterizer->clip;
+  if (clip.w <= 0 || clip.h <= 0)
+    return;
+
+  /* all segments in one pass: clip each against the rect once, then walk
+  ** Bresenham with no per-pixel bounds test */
+  for (int s = 0; s + 1 < count; s++)
+  {
+    double fx0 = points[s].x, fy0 = points[s].y;
+    double fx1 = points[s + 1].x, fy1 = points[s + 1].y;
+    if (!clip_segment(clip, &fx0, &fy0, &fx1, &fy1))
+      continue;
+
+    int x0 = (int)(fx0 + 0.5), y0 = (int)(fy0 + 0.5);
+    int x1 = (int)(fx1 + 0.5), y1 = (int)(fy1 + 0.5);
+    int dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    int dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+    /* the shared vertex was already drawn by the previous segment */
+    int skip = s > 0 && x0 == points[s].x && y0 == points[s].y;
+    for (;;)
+    {
+      if (!skip)
+      {
+        blend(&rasterizer->pixels[y0 * rasterizer->width + x0], color, color.alpha);
+        if (rasterizer->profile)
+          count_write(rasterizer, y0 * rasterizer->width + x0);
+      }
+      skip = 0;
+      if (x0 == x1 && y0 == y1)
+        break;
+      int e2 = 2 * err;
+      if (e2 >= dy)
+      {
+        err += dy;
+        x0 += sx;
+      }
+      if (e2 <= dx)
+      {
+        err += dx;
+        y0 += sy;
+      }
+    }
+  }
+}
+
+void rasterizer_draw_text(Rasterizer *rasterizer, const RasterizerFont *font, const char *text, mu_Vector2 position, mu_Color color)
+{
+  if (font->size > 0)
+  {
+    RasterizerProfile *profile = rasterizer->profile;
+    int written = sdf_font_draw(rasterizer->sdf, rasterizer->pixels, rasterizer->width, rasterizer->clip, text,
+                                position, font->size, color, profile ? profile->overdraw : NULL);
+    if (profile)
+      profile->written += written;
+    return;
+  }
+  int x = position.x;
+  for (const char *p = text; *p; p++)
+  {
+    if ((*p & 0xc0) == 0x80)
+      continue;
+    mu_Rectangle src = atlas_glyph(*p);
+    blit(rasterizer, src, x, position.y, color);
+    x += src.w;
+  }
+}
+
+void rasterizer_draw_icon(Rasterizer *rasterizer, int identifier, mu_Rectangle rectangle, mu_Color color)
+{
+  mu_Rectangle src = atlas[identifier];
+  int x = rectangle.x + (rectangle.w - src.w) / 2;
+  int y = rectangle.y + (rectangle.h - src.h) / 2;
+  blit(rasterizer, src, x, y, color);
+}
+
+void rasterizer_draw_image(Rasterizer *rasterizer, const RasterizerImage *image, mu_Rectangle source, mu_Rectangle rectangle, mu_Color color)
+{
+  mu_Rectangle dst = intersect(rectangle, rasterizer->clip);
+  if (source.w <= 0 || source.h <= 0 || rectangle.w <= 0 || rectangle.h <= 0)
+    return;
+
+  /* nearest-neighbour scale of the source region, tinted and blended */
+  for (int j = dst.y; j < dst.y + dst.h; j++)
+  {
+    int sy = source.y + (j - rectangle.y) * source.h / rectangle.h;
+    const mu_Color *row = image->pixels + sy * image->width;
+    mu_Color *out = rasterizer->pixels + j * rasterizer->width;
+    for (int i = dst.x; i < dst.x + dst.w; i++)
+    {
+      mu_Color texel = row[source.x + (i - rectangle.x) * source.w / rectangle.w];
+      mu_Color tinted = mu_color(texel.red * color.red / 255, texel.green * color.green / 255,
+                                 texel.blue * color.blue / 255, texel.alpha * color.alpha / 255);
+      blend(&out[i], tinted, tinted.alpha);
+    }
+  }
+}
+
+void rasterizer_draw_callback(Rasterizer *rasterizer, mu_DrawCallback callback, mu_Rectangle rectangle, void *user_data)
+{
+  /* callbacks write pixels directly and must honour rasterizer->clip;
+  ** restore it in case they narrowed it for their own drawing */
+  mu_Rectangle clip = rasterizer->clip;
+  callback(rasterizer, rectangle, user_data);
+  rasterizer->clip = clip;
+}
+
+int rasterizer_get_text_width(const RasterizerFont *font, const char *text, int length)
+{
+  if (font->size > 0)
+    return sdf_font_text_width(font->rasterizer->sdf, text, length, font->size);
+  return atlas_text_width(text, length);
+}
+
+int rasterizer_get_text_height(const RasterizerFont *font)
+{
+  if (font->size > 0)
+    return (int)ceilf(font->size);
+  return ATLAS_FONT_HEIGHT;
+}
+
+void rasterizer_set_clip_rect(Rasterizer *rasterizer, mu_Rectangle rectangle)
+{
+  rasterizer->clip = intersect(rectangle, rasterizer->scissor);
+}
+
+void rasterizer_clear(Rasterizer *rasterizer, mu_Color color)
+{
+  for (int i = 0; i < rasterizer->width * rasterizer->height; i++)
+    rasterizer->pixels[i] = color;
+  rasterizer->clip = mu_rect(0, 0, rasterizer->width, rasterizer->height);
+}
+
+static void draw_command(Rasterizer *rasterizer, mu_Command *command)
+{
+  switch (command->type)
+  {
+  case MU_COMMAND_TEXT:
+    rasterizer_draw_text(rasterizer, command->text.font, command->text.str, command->text.position, command->text.color);
+    break;
+  case MU_COMMAND_RECT:
+    rasterizer_draw_rect(rasterizer, command->rectangle.rectangle, command->rectangle.color);
+    break;
+  case MU_COMMAND_ICON:
+    rasterizer_draw_icon(rasterizer, command->icon.identifier, command->icon.rectangle, command->icon.color);
+    break;
+  case MU_COMMAND_CLIP:
+    rasterizer_set_clip_rect(rasterizer, command->clip.rectangle);
+    break;
+  case MU_COMMAND_LINES:
+    for (int i = 0; i < command->lines.count; i += command->lines.run)
+    {
+      rasterizer_draw_lines(rasterizer, command->lines.points + i, command->lines.run, command->lines.color);
+    }
+    break;
+  case MU_COMMAND_IMAGE:
+    rasterizer_draw_image(rasterizer, command->image.texture, command->image.source, command->image.rectangle, command->image.color);
+    break;
+  case MU_COMMAND_CALLBACK:
+    rasterizer_draw_callback(rasterizer, command->callback.callback, command->callback.rectangle, command->callback.user_data);
+    break;
+  }
+}
+
+/* every pixel a drawing command can write, before clipping */
+static mu_Rectangle command_bounds(Rasterizer *rasterizer, mu_Command *command)
+{
+  switch (command->type)
+  {
+  case MU_COMMAND_TEXT:
+  {
+    const RasterizerFont *font = command->text.font;
+    mu_Rectangle bounds = mu_rect(command->text.position.x, command->text.position.y,
+                                  rasterizer_get_text_width(font, command->text.str, strlen(command->text.str)),
+                                  rasterizer_get_text_height(font));
+    /* distance field glyphs carry their padding past the advance */
+    int pad = font->size > 0 ? (int)ceilf(SDF_SPREAD * font->size / rasterizer->sdf->height) + 1 : 0;
+    return mu_rect(bounds.x - pad, bounds.y - pad, bounds.w + 2 * pad, bounds.h + 2 * pad);
+  }
+  case MU_COMMAND_RECT:
+    return command->rectangle.rectangle;
+  case MU_COMMAND_ICON:
+  {
+    mu_Rectangle src = atlas[command->icon.identifier];
+    mu_Rectangle rectangle = command->icon.rectangle;
+    return mu_rect(rectangle.x + (rectangle.w - src.w) / 2, rectangle.y + (rectangle.h - src.h) / 2, src.w, src.h);
+  }
+  case MU_COMMAND_LINES:
+  {
+    const mu_Vector2 *points = command->lines.points;
+    int x1 = points[0].x, y1 = points[0].y, x2 = x1, y2 = y1;
+    for (int i = 1; i < command->lines.count; i++)
+    {
+      x1 = mu_min(x1, points[i].x);
+      y1 = mu_min(y1, points[i].y);
+      x2 = mu_max(x2, points[i].x);
+      y2 = mu_max(y2, points[i].y);
+    }
+    return mu_rect(x1, y1, x2 - x1 + 1, y2 - y1 + 1);
+  }
+  case MU_COMMAND_IMAGE:
+    return command->image.rectangle;
+  case MU_COMMAND_CALLBACK:
+    return command->callback.rectangle;
+  }
+  return mu_rect(0, 0, 0, 0);
+}
+
+/* FNV-1a */
+static unsigned long long hash_bytes(unsigned long long hash, const void *data, size_t size)
+{
+  const unsigned char *p = data;
+  while (size--)
+    hash = (hash ^ *p++) * 1099511628211ull;
+  return hash;
+}
+
+/* hash of everything that decides what a command writes inside `bounds` */
+static unsigned long long hash_command(Rasterizer *rasterizer, mu_Command *command, mu_Rectangle bounds)
+{
+  unsigned long long hash = hash_bytes(14695981039346656037ull, &command->type, sizeof(command->type));
+  hash = hash_bytes(hash, &bounds, sizeof(bounds));
+  switch (command->type)
+  {
+  case MU_COMMAND_TEXT:
+    hash = hash_bytes(hash, &command->text.font, sizeof(command->text.font));
+    hash = hash_bytes(hash, &command->text.position, sizeof(command->text.position));
+    hash = hash_bytes(hash, &command->text.color, sizeof(command->text.color));
+    hash = hash_bytes(hash, command->text.str, strlen(command->text.str));
+    break;
+  case MU_COMMAND_RECT:
+    hash = hash_bytes(hash, &command->rectangle.rectangle, sizeof(command->rectangle.rectangle));
+    hash = hash_bytes(hash, &command->rectangle.color, sizeof(command->rectangle.color));
+    break;
+  case MU_COMMAND_ICON:
+    hash = hash_bytes(hash, &command->icon.identifier, sizeof(command->icon.identifier));
+    hash = hash_bytes(hash, &command->icon.color, sizeof(command->icon.color));
+    break;
+  case MU_COMMAND_LINES:
+    hash = hash_bytes(hash, &command->lines.color, sizeof(command->lines.color));
+    hash = hash_bytes(hash, &command->lines.run, sizeof(command->lines.run));
+    hash = hash_bytes(hash, command->lines.points, command->lines.count * sizeof(mu_Vector2));
+    break;
+  case MU_COMMAND_IMAGE:
+  {
+    const RasterizerImage *image = command->image.texture;
+    hash = hash_bytes(hash, &command->image.texture, sizeof(command->image.texture));
+    hash = hash_bytes(hash, &image->version, sizeof(image->version));
+    hash = hash_bytes(hash, &command->image.source, sizeof(command->image.source));
+    hash = hash_bytes(hash, &command->image.rectangle, sizeof(command->image.rectangle));
+    hash = hash_bytes(hash, &command->image.color, sizeof(command->image.color));
+    break;
+  }
+  case MU_COMMAND_CALLBACK:
+    /* what a callback draws is unknown, so its tiles repaint every frame */
+    hash = hash_bytes(hash, &rasterizer->frame, sizeof(rasterizer->frame));
+    break;
+  }
+  return hash;
+}
+
+/* merge the dirty tiles into rectangles: runs along each tile row, grown
+** downwards while the row below has a run with the same span */
+static void collect_dirty(Rasterizer *rasterizer, const unsigned char *dirty)
+{
+  rasterizer->dirty_count = 0;
+  for (int ty = 0; ty < rasterizer->tiles_y; ty++)
+  {
+    int row = rasterizer->dirty_count;
+    int y = ty * RASTERIZER_TILE, h = mu_min(RASTERIZER_TILE, rasterizer->height - y);
+    for (int tx = 0; tx < rasterizer->tiles_x;)
+    {
+      if (!dirty[ty * rasterizer->tiles_x + tx])
+      {
+        tx++;
+        continue;
+      }
+      int first = tx;
+      while (tx < rasterizer->tiles_x && dirty[ty * rasterizer->tiles_x + tx])
+        tx++;
+      int x = first * RASTERIZER_TILE, w = mu_min(tx * RASTERIZER_TILE, rasterizer->width) - x;
+
+      mu_Rectangle *above = NULL;
+      for (int i = 0; i < row && !above; i++)
+      {
+        mu_Rectangle *r = &rasterizer->dirty[i];
+        if (r->x == x && r->w == w && r->y + r->h == y)
+          above = r;
+      }
+      if (above)
+        above->h += h;
+      else
+        rasterizer->dirty[rasterizer->dirty_count++] = mu_rect(x, y, w, h);
+    }
+  }
+}
+
+static double seconds(void)
+{
+  struct timespec now;
+  timespec_get(&now, TIME_UTC);
+  return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+/* draw an item inside `area`, charging its time and the pixels it writes
+** to its command type and its root container. an item drawn into several
+** dirty regions adds time and pixels for each but is counted once */
+static void profile_command(Rasterizer *rasterizer, RasterizerItem *item, mu_Rectangle area)
+{
+  RasterizerProfile *profile = rasterizer->profile;
+  int type = item->command->type;
+  long written = profile->written;
+  double start = seconds();
+  draw_command(rasterizer, item->command);
+  double elapsed = seconds() - start;
+
+  /* text, icons and lines count the pixels they plot; rects, images and
+  ** callbacks write the whole of their clipped area */
+  if (type == MU_COMMAND_RECT || type == MU_COMMAND_IMAGE || type == MU_COMMAND_CALLBACK)
+  {
+    area = intersect(area, rasterizer->clip);
+    for (int j = area.y; j < area.y + area.h; j++)
+    {
+      for (int i = area.x; i < area.x + area.w; i++)
+        count_write(rasterizer, j * rasterizer->width + i);
+    }
+  }
+
+  long pixels = profile->written - written;
+  int first = !item->profiled;
+  item->profiled = 1;
+  profile->type_count[type] += first;
+  profile->type_pixels[type] += pixels;
+  profile->type_seconds[type] += elapsed;
+
+  int r = 0;
+  while (r < profile->root_total && profile->roots[r] != item->root)
+    r++;
+  if (r == MU_ROOTLIST_SIZE)
+    return;
+  if (r == profile->root_total)
+  {
+    profile->roots[profile->root_total++] = item->root;
+  }
+  profile->root_rects[r] = item->root->rectangle;
+  profile->root_count[r] += first;
+  profile->root_pixels[r] += pixels;
+  profile->root_seconds[r] += elapsed;
+}
+
+int rasterizer_render(Rasterizer *rasterizer, mu_Context *context, mu_Color background)
+{
+  mu_Rectangle screen = mu_rect(0, 0, rasterizer->width, rasterizer->height);
+  int tiles = rasterizer->tiles_x * rasterizer->tiles_y;
+  unsigned long long seed = hash_bytes(14695981039346656037ull, &background, sizeof(background));
+  for (int i = 0; i < tiles; i++)
+    rasterizer->next_hashes[i] = seed;
+
+  /* fold each command into the hash of every tile it can write, in order;
+  ** walked per root container, which is the same order, to tag each with it */
+  int count = 0;
+  mu_Rectangle clip = screen;
+  for (int r = 0; r < context->root_list.idx; r++)
+  {
+    mu_Container *root = context->root_list.items[r];
+    mu_Command *command = NULL;
+    while (mu_next_container_command(root, &command))
+    {
+      mu_Rectangle bounds;
+      if (command->type == MU_COMMAND_CLIP)
+      {
+        clip = intersect(command->clip.rectangle, screen);
+        bounds = clip;
+      }
+      else
+      {
+        bounds = intersect(command_bounds(rasterizer, command), clip);
+        if (bounds.w <= 0 || bounds.h <= 0)
+          continue;
+        unsigned long long hash = hash_command(rasterizer, command, bounds);
+        for (int ty = bounds.y / RASTERIZER_TILE; ty <= (bounds.y + bounds.h - 1) / RASTERIZER_TILE; ty++)
+        {
+          unsigned long long *row = rasterizer->next_hashes + ty * rasterizer->tiles_x;
+          for (int tx = bounds.x / RASTERIZER_TILE; tx <= (bounds.x + bounds.w - 1) / RASTERIZER_TILE; tx++)
+            row[tx] = (row[tx] ^ hash) * 1099511628211ull;
+        }
+      }
+      if (count == rasterizer->item_capacity)
+      {
+        int capacity = mu_max(rasterizer->item_capacity * 2, 1024);
+        RasterizerItem *items = realloc(rasterizer->items, capacity * sizeof(RasterizerItem));
+        if (!items)
+        {
+          fprintf(stderr, "Failed to allocate %d raster items\n", capacity);
+          exit(1);
+        }
+        rasterizer->items = items;
+        rasterizer->item_capacity = capacity;
+      }
+      rasterizer->items[count++] = (RasterizerItem){command, bounds, root, 0};
+    }
+  }
+
+  /* tiles whose hash changed are the only ones drawn again */
+  for (int i = 0; i < tiles; i++)
+  {
+    rasterizer->dirty_tiles[i] = rasterizer->repaint_all || rasterizer->next_hashes[i] != rasterizer->tile_hashes[i];
+    rasterizer->tile_hashes[i] = rasterizer->next_hashes[i];
+  }
+  collect_dirty(rasterizer, rasterizer->dirty_tiles);
+
+  /* replay the commands overlapping each region with the region as scissor */
+  for (int d = 0; d < rasterizer->dirty_count; d++)
+  {
+    mu_Rectangle region = rasterizer->dirty[d];
+    for (int j = region.y; j < region.y + region.h; j++)
+    {
+      mu_Color *out = rasterizer->pixels + j * rasterizer->width;
+      for (int i = region.x; i < region.x + region.w; i++)
+        out[i] = background;
+    }
+    rasterizer->scissor = region;
+    rasterizer->clip = region;
+    for (int i = 0; i < count; i++)
+    {
+      RasterizerItem *item = &rasterizer->items[i];
+      if (item->command->type == MU_COMMAND_CLIP)
+      {
+        rasterizer_set_clip_rect(rasterizer, item->bounds);
+        continue;
+      }
+      mu_Rectangle overlap = intersect(item->bounds, region);
+      if (overlap.w > 0 && overlap.h > 0 && rasterizer->profile)
+        profile_command(rasterizer, item, overlap);
+      else if (overlap.w > 0 && overlap.h > 0)
+        draw_command(rasterizer, item->command);
+    }
+  }
+  rasterizer->scissor = screen;
+  rasterizer->clip = screen;
+  rasterizer->repaint_all = 0;
+  rasterizer->frame++;
+  return rasterizer->dirty_count;
+}
+
+void rasterizer_invalidate(Rasterizer *rasterizer)
+{
+  rasterizer->repaint_all = 1;
+}
+
+void rasterizer_profile(Rasterizer *rasterizer, int enabled)
+{
+  if (rasterizer->profile)
+  {
+    free(rasterizer->profile->overdraw);
+    free(rasterizer->profile);
+    rasterizer->profile = NULL;
+  }
+  if (!enabled)
+    return;
+
+  RasterizerProfile *profile = calloc(1, sizeof(RasterizerProfile));
+  unsigned short *overdraw = calloc((size_t)rasterizer->width * rasterizer->height, sizeof(unsigned short));
+  if (!profile || !overdraw)
+  {
+    fprintf(stderr, "Failed to allocate profile\n");
+    free(profile);
+    free(overdraw);
+    return;
+  }
+  profile->overdraw = overdraw;
+  rasterizer->profile = profile;
+}
+
+int rasterizer_write_profile(Rasterizer *rasterizer, const char *image_path, const char *csv_path)
+{
+  static const char *type_names[MU_COMMAND_MAX] = {
+      [MU_COMMAND_RECT] = "rect", [MU_COMMAND_TEXT] = "text",
+      [MU_COMMAND_ICON] = "icon", [MU_COMMAND_LINES] = "lines", [MU_COMMAND_IMAGE] = "image",
+      [MU_COMMAND_CALLBACK] = "callback"};
+  /* 0 covers, then 1, 2, 3, 4, 5, 6 and up */
+  static const mu_Color ramp[] = {{0, 0, 0, 0}, {40, 70, 200, 255}, {40, 170, 90, 255}, {230, 220, 60, 255},
+                                  {240, 150, 40, 255}, {230, 60, 40, 255}, {255, 255, 255, 255}};
+  const int steps = sizeof(ramp) / sizeof(*ramp);
+  RasterizerProfile *profile = rasterizer->profile;
+  if (!profile)
+  {
+    fprintf(stderr, "Profiling is not enabled\n");
+    return 0;
+  }
+
+  FILE *fp = fopen(image_path, "wb");
+  if (!fp)
+  {
+    fprintf(stderr, "Failed to open %s for writing\n", image_path);
+    return 0;
+  }
+  /* the frame dimmed to grey so windows stay recognisable under the heat */
+  fprintf(fp, "P6\n%d %d\n255\n", rasterizer->width, rasterizer->height);
+  for (int i = 0; i < rasterizer->width * rasterizer->height; i++)
+  {
+    mu_Color c = rasterizer->pixels[i];
+    int grey = (c.red * 3 + c.green * 6 + c.blue) / 30;
+    mu_Color heat = ramp[mu_min(profile->overdraw[i], steps - 1)];
+    int alpha = profile->overdraw[i] ? 200 : 0;
+    unsigned char rgb[3] = {(heat.red * alpha + grey * (255 - alpha)) / 255,
+                            (heat.green * alpha + grey * (255 - alpha)) / 255,
+                            (heat.blue * alpha + grey * (255 - alpha)) / 255};
+    fwrite(rgb, 1, 3, fp);
+  }
+  fclose(fp);
+
+  fp = fopen(csv_path, "w");
+  if (!fp)
+  {
+    fprintf(stderr, "Failed to open %s for writing\n", csv_path);
+    return 0;
+  }
+  /* pixels over area is the overdraw a group adds; roots are named by rect */
+  fprintf(fp, "group,name,commands,pixels,milliseconds\n");
+  /* jumps and clips are never drawn, so never charged */
+  for (int t = MU_COMMAND_RECT; t < MU_COMMAND_MAX; t++)
+  {
+    if (profile->type_count[t] && type_names[t])
+      fprintf(fp, "type,%s,%d,%ld,%.3f\n", type_names[t], profile->type_count[t], profile->type_pixels[t],
+              profile->type_seconds[t] * 1000);
+  }
+  for (int r = 0; r < profile->root_total; r++)
+  {
+    mu_Rectangle rect = profile->root_rects[r];
+    fprintf(fp, "root,%dx%d+%d+%d,%d,%ld,%.3f\n", rect.w, rect.h, rect.x, rect.y, profile->root_count[r],
+            profile->root_pixels[r], profile->root_seconds[r] * 1000);
+  }
+  fclose(fp);
+  return 1;
+}
+
+int rasterizer_write_ppm(Rasterizer *rasterizer, const char *path)
+{
+  FILE *fp = fopen(path, "wb");
+  if (!fp)
+  {
+    fprintf(stderr, "Failed to open %s for writing\n", path);
+    return 0;
+  }
+  fprintf(fp, "P6\n%d %d\n255\n", rasterizer->width, rasterizer->height);
+  for (int i = 0; i < rasterizer->width * rasterizer->height; i++)
+  {
+    mu_Color c = rasterizer->pixels[i];
+    unsigned char rgb[3] = {c.red, c.green, c.blue};
+    fwrite(rgb, 1, 3, fp);
+  }
+  fclose(fp);
+  return 1;
+}
@@ -0,0 +1,214 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdf_font.h"
+#include "atlas_font.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SDF_SSE
+#endif
+
+/* pixels of a glyph row resampled per pass */
+enum { SDF_CHUNK = 256 };
+
+static int covered(mu_Rectangle src, int x, int y)
+{
+  if (x < 0 || y < 0 || x >= src.w || y >= src.h)
+    return 0;
+  return atlas_texture[(src.y + y) * ATLAS_WIDTH + src.x + x] >= 128;
+}
+
+/* distance from each padded texel to the nearest texel on the other side
+** of the edge; glyphs are tiny, so a windowed search is cheap enough */
+static void build_glyph(unsigned char *out, mu_Rectangle src, int width, int height)
+{
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      int inside = covered(src, x - SDF_SPREAD, y - SDF_SPREAD);
+      int best = (SDF_SPREAD + 1) * (SDF_SPREAD + 1);
+      for (int dy = -SDF_SPREAD; dy <= SDF_SPREAD; dy++)
+      {
+        for (int dx = -SDF_SPREAD; dx <= SDF_SPREAD; dx++)
+        {
+          if (covered(src, x - SDF_SPREAD + dx, y - SDF_SPREAD + dy) != inside)
+            best = mu_min(best, dx * dx + dy * dy);
+        }
+      }
+      float distance = sqrtf((float)best) - 0.5f;
+      distance = fminf(distance, (float)SDF_SPREAD);
+      out[y * width + x] = (unsigned char)(128 + (inside ? distance : -distance) * 127 / SDF_SPREAD);
+    }
+  }
+}
+
+SdfFont *sdf_font_create(void)
+{
+  SdfFont *font = calloc(1, sizeof(SdfFont));
+  if (!font)
+    return NULL;
+
+  int total = 0;
+  for (int c = 0; c < SDF_GLYPHS; c++)
+  {
+    mu_Rectangle src = atlas[ATLAS_FONT + c];
+    SdfGlyph *glyph = &font->glyphs[c];
+    glyph->offset = total;
+    glyph->width = src.w ? src.w + SDF_SPREAD * 2 : 0;
+    glyph->height = src.w ? src.h + SDF_SPREAD * 2 : 0;
+    glyph->advance = src.w;
+    total += glyph->width * glyph->height;
+  }
+
+  font->field = malloc(total);
+  if (!font->field)
+  {
+    fprintf(stderr, "Failed to allocate SDF field\n");
+    free(font);
+    return NULL;
+  }
+  for (int c = 0; c < SDF_GLYPHS; c++)
+  {
+    SdfGlyph *glyph = &font->glyphs[c];
+    build_glyph(font->field + glyph->offset, atlas[ATLAS_FONT + c], glyph->width, glyph->height);
+  }
+  font->height = ATLAS_FONT_HEIGHT;
+  return font;
+}
+
+void sdf_font_destroy(SdfFont *font)
+{
+  if (!font)
+    return;
+  free(font->field);
+  free(font);
+}
+
+static const SdfGlyph *glyph_of(const SdfFont *font, unsigned char c)
+{
+  return &font->glyphs[mu_min(c, SDF_GLYPHS - 1)];
+}
+
+int sdf_font_text_width(const SdfFont *font, const char *text, int length, float size)
+{
+  /* sum in texels and scale once, so widths agree with the pen in draw */
+  int advance = 0;
+  for (const char *p = text; *p && length--; p++)
+  {
+    if ((*p & 0xc0) == 0x80)
+      continue;
+    advance += glyph_of(font, *p)->advance;
+  }
+  return (int)lroundf(advance * size / font->height);
+}
+
+/* threshold and smoothstep distances in [0, 1] into 0..255 coverage */
+static void coverage(const float *distance, unsigned char *alpha, int n, float edge0, float edge1)
+{
+  float inverse = 1.0f / (edge1 - edge0);
+  int i = 0;
+#if defined(SDF_SSE)
+  __m128 e0 = _mm_set1_ps(edge0), inv = _mm_set1_ps(inverse);
+  __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1), three = _mm_set1_ps(3), two = _mm_set1_ps(2);
+  __m128 full = _mm_set1_ps(255);
+  for (; i + 4 <= n; i += 4)
+  {
+    __m128 t = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(distance + i), e0), inv);
+    t = _mm_min_ps(_mm_max_ps(t, zero), one);
+    t = _mm_mul_ps(_mm_mul_ps(t, t), _mm_sub_ps(three, _mm_mul_ps(two, t)));
+    __m128i a = _mm_cvtps_epi32(_mm_mul_ps(t, full));
+    a = _mm_packs_epi32(a, a);
+    a = _mm_packus_epi16(a, a);
+    int packed = _mm_cvtsi128_si32(a);
+    memcpy(alpha + i, &packed, 4);
+  }
+#endif
+  for (; i < n; i++)
+  {
+    float t = fminf(fmaxf((distance[i] - edge0) * inverse, 0), 1);
+    alpha[i] = (unsigned char)lroundf(t * t * (3 - 2 * t) * 255);
+  }
+}
+
+static float sample(const SdfGlyph *glyph, const unsigned char *field, float u, float v)
+{
+  /* bilinear, with the padding ring standing in for everything outside */
+  u = fminf(fmaxf(u, 0), glyph->width - 1.001f);
+  v = fminf(fmaxf(v, 0), glyph->height - 1.001f);
+  int x = (int)u, y = (int)v;
+  float fx = u - x, fy = v - y;
+  const unsigned char *p = field + y * glyph->width + x;
+  float top = p[0] + (p[1] - p[0]) * fx;
+  float bottom = p[glyph->width] + (p[glyph->width + 1] - p[glyph->width]) * fx;
+  return (top + (bottom - top) * fy) / 255.0f;
+}
+
+static int draw_glyph(const SdfFont *font, const SdfGlyph *glyph, mu_Color *pixels, int stride,
+                      mu_Rectangle clip, float gx, float gy, float scale, mu_Color color, unsigned short *counts)
+{
+  int written = 0;
+  const unsigned char *field = font->field + glyph->offset;
+  int x1 = mu_max(clip.x, (int)floorf(gx)), x2 = mu_min(clip.x + clip.w, (int)ceilf(gx + glyph->width * scale));
+  int y1 = mu_max(clip.y, (int)floorf(gy)), y2 = mu_min(clip.y + clip.h, (int)ceilf(gy + glyph->height * scale));
+
+  /* one destination pixel spans 1/scale texels; blur the edge over it */
+  float half = 0.5f * 127.0f / SDF_SPREAD / 255.0f / scale;
+  float distance[SDF_CHUNK];
+  unsigned char alpha[SDF_CHUNK];
+
+  for (int y = y1; y < y2; y++)
+  {
+    float v = (y + 0.5f - gy) / scale - 0.5f;
+    for (int x0 = x1; x0 < x2; x0 += SDF_CHUNK)
+    {
+      int n = mu_min(SDF_CHUNK, x2 - x0);
+      for (int i = 0; i < n; i++)
+        distance[i] = sample(glyph, field, (x0 + i + 0.5f - gx) / scale - 0.5f, v);
+      coverage(distance, alpha, n, 0.5f - half, 0.5f + half);
+
+      mu_Color *out = pixels + y * stride + x0;
+      for (int i = 0; i < n; i++)
+      {
+        int a = alpha[i] * color.alpha / 255;
+        if (a)
+        {
+          out[i].red = (color.red * a + out[i].red * (255 - a)) / 255;
+          out[i].green = (color.green * a + out[i].green * (255 - a)) / 255;
+          out[i].blue = (color.blue * a + out[i].blue * (255 - a)) / 255;
+          if (counts)
+          {
+            unsigned short *count = counts + y * stride + x0 + i;
+            *count += *count < 0xffff;
+            written++;
+          }
+        }
+      }
+    }
+  }
+  return written;
+}
+
+int sdf_font_draw(const SdfFont *font, mu_Color *pixels, int stride, mu_Rectangle clip,
+                  const char *text, mu_Vector2 position, float size, mu_Color color, unsigned short *counts)
+{
+  int written = 0;
+  float scale = size / font->height;
+  int advance = 0;
+  for (const char *p = text; *p; p++)
+  {
+    if ((*p & 0xc0) == 0x80)
+      continue;
+    const SdfGlyph *glyph = glyph_of(font, *p);
+    /* pen positions come from the same scaled sums as the measured width */
+    float pen = position.x + lroundf(advance * scale);
+    if (glyph->width)
+      written += draw_glyph(font, glyph, pixels, stride, clip, pen - SDF_SPREAD * scale,
+                            position.y - SDF_SPREAD * scale, scale, color, counts);
+    advance += glyph->advance;
+  }
+  return written;
+}
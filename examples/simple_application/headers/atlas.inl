@@ -1,10 +1,7 @@
-#include "microui.h"
+#include "atlas_font.h"
 
-enum { ATLAS_WHITE = MU_ICON_MAX, ATLAS_FONT };
-enum { ATLAS_WIDTH = 128, ATLAS_HEIGHT = 128 };
 
-
-static unsigned char atlas_texture[ATLAS_WIDTH * ATLAS_HEIGHT] = {
+const unsigned char atlas_texture[ATLAS_WIDTH * ATLAS_HEIGHT] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -890,7 +887,7 @@ static unsigned char atlas_texture[ATLAS_WIDTH * ATLAS_HEIGHT] = {
 };
 
 
-static mu_Rectangle atlas[] = {
+const mu_Rectangle atlas[ATLAS_FONT + 128] = {
   [ MU_ICON_CLOSE ] = { 88, 68, 16, 16 },
   [ MU_ICON_CHECK ] = { 0, 0, 18, 18 },
   [ MU_ICON_EXPANDED ] = { 118, 68, 7, 5 },
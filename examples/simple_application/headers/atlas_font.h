@@ -0,0 +1,25 @@
+#ifndef ATLAS_FONT_H
+#define ATLAS_FONT_H
+
+/* Bitmap font over the glyphs in atlas.inl, shared by the SDL and headless
+** backends. Measuring is a lookup-and-sum over the glyph widths, so no
+** backend has to shape text or allocate to answer text_width. The atlas
+** data itself lives in atlas_font.c only. */
+
+#include "microui.h"
+
+enum { ATLAS_WHITE = MU_ICON_MAX, ATLAS_FONT };
+enum { ATLAS_WIDTH = 128, ATLAS_HEIGHT = 128 };
+enum { ATLAS_FONT_HEIGHT = 18 };
+
+/* alpha coverage of every icon and glyph */
+extern const unsigned char atlas_texture[ATLAS_WIDTH * ATLAS_HEIGHT];
+/* icons by MU_ICON_*, the white block, then glyphs from ATLAS_FONT */
+extern const mu_Rectangle atlas[ATLAS_FONT + 128];
+
+/* atlas region of a byte; everything past ASCII draws as the last glyph */
+mu_Rectangle atlas_glyph(unsigned char c);
+/* width of the first `length` bytes of text, or all of it if negative */
+int atlas_text_width(const char *text, int length);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include "microui.h"
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+
+/* Glyphs rasterized once by SDL_ttf and packed into one texture with a
+** skyline allocator. When the texture or the lookup table fills up, glyphs
+** not used in the current frame are evicted and the rest are repacked. */
+
+enum
+{
+  GLYPH_ATLAS_SIZE = 512,   /* texture width and height */
+  GLYPH_ATLAS_SLOTS = 1024, /* lookup table size (power of two) */
+  GLYPH_ATLAS_NODES = 512   /* skyline segments */
+};
+
+typedef struct Glyph {
+  Uint32 codepoint;
+  int used;
+  mu_Rectangle rect; /* texels; also the on-screen size */
+  int advance;
+  Uint64 last_used;
+} Glyph;
+
+typedef struct SkylineNode {
+  int x;
+  int y;
+  int width;
+} SkylineNode;
+
+typedef struct GlyphAtlas {
+  SDL_Renderer *renderer;
+  TTF_Font *font;
+  SDL_Texture *texture;
+  mu_Rectangle white; /* opaque block so rects can share the texture */
+  unsigned char *pixels;  /* RGBA copy of the texture */
+  unsigned char *scratch; /* previous layout while repacking */
+  SkylineNode nodes[GLYPH_ATLAS_NODES];
+  int node_count;
+  Glyph glyphs[GLYPH_ATLAS_SLOTS];
+  int glyph_count;
+  Uint64 frame;
+  /* called before existing glyphs move, so queued quads can be drawn */
+  void (*flush)(void *user);
+  void *user;
+} GlyphAtlas;
+
+GlyphAtlas *glyph_atlas_create(SDL_Renderer *renderer, TTF_Font *font, void (*flush)(void *user), void *user);
+void glyph_atlas_destroy(GlyphAtlas *atlas);
+/* returns NULL if the glyph cannot be rasterized or is larger than the atlas */
+const Glyph *glyph_atlas_get(GlyphAtlas *atlas, Uint32 codepoint);
+Uint32 glyph_atlas_decode(const char **text, const char *end);
+int glyph_atlas_text_width(GlyphAtlas *atlas, const char *text, int length);
+void glyph_atlas_next_frame(GlyphAtlas *atlas);
+
+#endif
@@ -4,6 +4,27 @@
 #include "microui.h"
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
+#include "glyph_atlas.h"
+
+/* How text is measured and drawn */
+typedef enum RendererText {
+  RENDERER_TEXT_TTF,  /* system font glyphs cached in a packed GlyphAtlas */
+  RENDERER_TEXT_ATLAS /* bitmap glyphs from atlas.inl, batched with rects/icons */
+} RendererText;
+
+enum { RENDERER_BATCH_QUADS = 4096, RENDERER_LAYERS = MU_ROOTLIST_SIZE };
+
+/* A root container's last drawing, kept in a target texture and composited
+** with one blit until the container's commands change */
+typedef struct RendererLayer {
+  const mu_Container *key; /* container it caches, NULL when free */
+  unsigned hash;           /* commands it holds, relative to the container */
+  int width;
+  int height;
+  int drawn;               /* texture holds the commands in `hash` */
+  int used;                /* composited since the last present */
+  SDL_Texture *texture;
+} RendererLayer;
 
 typedef struct Renderer {
   int width;
@@ -12,13 +33,43 @@ typedef struct Renderer {
   SDL_Renderer *renderer;
   SDL_Texture *atlas_texture;
   TTF_Font *font;
+  RendererText text;
+  GlyphAtlas *glyphs;
+  /* textured quads queued for one SDL_RenderGeometry call */
+  SDL_Texture *batch_texture;
+  SDL_Vertex vertices[RENDERER_BATCH_QUADS * 4];
+  int indices[RENDERER_BATCH_QUADS * 6];
+  int quad_count;
+  /* subtracted from every position while drawing into a layer */
+  mu_Vector2 origin;
+  RendererLayer layers[RENDERER_LAYERS];
 } Renderer;
 
-Renderer *renderer_init(void);
+/* App-owned RGBA32 pixels streamed into a texture; only dirty rows upload */
+typedef struct RendererImage {
+  int width;
+  int height;
+  const unsigned char *pixels;
+  int dirty_top;
+  int dirty_bottom;
+  SDL_Texture *texture;
+} RendererImage;
+
+Renderer *renderer_init(RendererText text);
+void renderer_flush(Renderer *renderer);
 void renderer_destroy(Renderer *renderer);
 void renderer_draw_rect(Renderer *renderer, mu_Rectangle rectangle, mu_Color color);
+void renderer_draw_lines(Renderer *renderer, const mu_Vector2 *points, int count, mu_Color color);
 void renderer_draw_text(Renderer *renderer, const char *text, mu_Vector2 position, mu_Color color);
 void renderer_draw_icon(Renderer *renderer, int identifier, mu_Rectangle rectangle, mu_Color color);
+void renderer_draw_image(Renderer *renderer, RendererImage *image, mu_Rectangle source, mu_Rectangle rectangle, mu_Color color);
+RendererImage *renderer_create_image(Renderer *renderer, int width, int height, const unsigned char *pixels);
+void renderer_destroy_image(RendererImage *image);
+void renderer_mark_image_rows(RendererImage *image, int first, int count);
+void renderer_update_image(RendererImage *image);
+void renderer_draw_callback(Renderer *renderer, mu_DrawCallback callback, mu_Rectangle rectangle, void *user_data);
+void renderer_draw_container(Renderer *renderer, mu_Container *container);
+void renderer_invalidate_layers(Renderer *renderer);
 int renderer_get_text_width(Renderer *renderer, const char *text, int length);
 int renderer_get_text_height(Renderer *renderer);
 void renderer_set_clip_rect(Renderer *renderer, mu_Rectangle rectangle);
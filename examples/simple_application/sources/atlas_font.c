@@ -0,0 +1,28 @@
+#include "atlas_font.h"
+#include "atlas.inl"
+
+mu_Rectangle atlas_glyph(unsigned char c)
+{
+  return atlas[ATLAS_FONT + mu_min(c, 127)];
+}
+
+/* utf-8 continuation bytes take no space */
+static int advance(unsigned char c)
+{
+  return (c & 0xc0) == 0x80 ? 0 : atlas_glyph(c).w;
+}
+
+int atlas_text_width(const char *text, int length)
+{
+  const unsigned char *p = (const unsigned char *)text;
+  int width = 0;
+  if (length < 0)
+  {
+    while (*p)
+      width += advance(*p++);
+    return width;
+  }
+  for (int i = 0; i < length && p[i]; i++)
+    width += advance(p[i]);
+  return width;
+}
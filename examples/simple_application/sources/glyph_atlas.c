@@ -0,0 +1,268 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "glyph_atlas.h"
+
+/* blank texels kept around each glyph so filtering never bleeds */
+enum { GLYPH_PADDING = 1 };
+
+/*============================================================================
+** skyline packer
+**============================================================================*/
+
+/* y at which a w*h box rests if its left edge is at node `index`, or -1 */
+static int skyline_fit(GlyphAtlas *atlas, int index, int w, int h)
+{
+  int x = atlas->nodes[index].x, y = 0, remaining = w;
+  if (x + w > GLYPH_ATLAS_SIZE)
+    return -1;
+  for (int i = index; remaining > 0; i++)
+  {
+    if (i == atlas->node_count)
+      return -1;
+    y = mu_max(y, atlas->nodes[i].y);
+    if (y + h > GLYPH_ATLAS_SIZE)
+      return -1;
+    remaining -= atlas->nodes[i].width;
+  }
+  return y;
+}
+
+static int skyline_pack(GlyphAtlas *atlas, int w, int h, mu_Rectangle *out)
+{
+  int best = -1, best_y = GLYPH_ATLAS_SIZE, best_width = GLYPH_ATLAS_SIZE;
+  SkylineNode *nodes = atlas->nodes;
+
+  /* bottom-left rule: lowest resting place, narrowest segment on ties */
+  for (int i = 0; i < atlas->node_count; i++)
+  {
+    int y = skyline_fit(atlas, i, w, h);
+    if (y >= 0 && (y < best_y || (y == best_y && nodes[i].width < best_width)))
+    {
+      best = i;
+      best_y = y;
+      best_width = nodes[i].width;
+    }
+  }
+  if (best < 0 || atlas->node_count == GLYPH_ATLAS_NODES)
+    return 0;
+
+  /* raise the skyline over the box, trimming the segments it covers */
+  *out = mu_rect(nodes[best].x, best_y, w, h);
+  memmove(nodes + best + 1, nodes + best, (atlas->node_count - best) * sizeof(*nodes));
+  nodes[best] = (SkylineNode){out->x, best_y + h, w};
+  atlas->node_count++;
+  for (int i = best + 1; i < atlas->node_count; i++)
+  {
+    int overlap = nodes[i - 1].x + nodes[i - 1].width - nodes[i].x;
+    if (overlap <= 0)
+      break;
+    nodes[i].x += overlap;
+    nodes[i].width -= overlap;
+    if (nodes[i].width > 0)
+      break;
+    memmove(nodes + i, nodes + i + 1, (atlas->node_count - i - 1) * sizeof(*nodes));
+    atlas->node_count--;
+    i--;
+  }
+
+  /* merge neighbours at the same height */
+  for (int i = 0; i + 1 < atlas->node_count; i++)
+  {
+    if (nodes[i].y == nodes[i + 1].y)
+    {
+      nodes[i].width += nodes[i + 1].width;
+      memmove(nodes + i + 1, nodes + i + 2, (atlas->node_count - i - 2) * sizeof(*nodes));
+      atlas->node_count--;
+      i--;
+    }
+  }
+  return 1;
+}
+
+static void blit(GlyphAtlas *atlas, mu_Rectangle rect, const unsigned char *pixels, int pitch)
+{
+  for (int y = 0; y < rect.h; y++)
+  {
+    memcpy(atlas->pixels + ((rect.y + y) * GLYPH_ATLAS_SIZE + rect.x) * 4, pixels + y * pitch, rect.w * 4);
+  }
+}
+
+/* empty the texture, keeping only the white block */
+static void reset(GlyphAtlas *atlas)
+{
+  unsigned char white[3 * 3 * 4];
+  memset(white, 255, sizeof(white));
+  memset(atlas->pixels, 0, GLYPH_ATLAS_SIZE * GLYPH_ATLAS_SIZE * 4);
+  memset(atlas->glyphs, 0, sizeof(atlas->glyphs));
+  atlas->glyph_count = 0;
+  atlas->nodes[0] = (SkylineNode){0, 0, GLYPH_ATLAS_SIZE};
+  atlas->node_count = 1;
+  skyline_pack(atlas, 3 + GLYPH_PADDING, 3 + GLYPH_PADDING, &atlas->white);
+  atlas->white = mu_rect(atlas->white.x + 1, atlas->white.y + 1, 1, 1);
+  blit(atlas, mu_rect(atlas->white.x - 1, atlas->white.y - 1, 3, 3), white, 3 * 4);
+}
+
+/*============================================================================
+** glyph table
+**============================================================================*/
+
+static Glyph *slot(GlyphAtlas *atlas, Uint32 codepoint)
+{
+  int i = (codepoint * 2654435761u) & (GLYPH_ATLAS_SLOTS - 1);
+  while (atlas->glyphs[i].used && atlas->glyphs[i].codepoint != codepoint)
+    i = (i + 1) & (GLYPH_ATLAS_SLOTS - 1);
+  return &atlas->glyphs[i];
+}
+
+/* evict glyphs unused this frame and pack the survivors into a fresh layout */
+static void repack(GlyphAtlas *atlas)
+{
+  static Glyph old[GLYPH_ATLAS_SLOTS];
+  if (atlas->flush)
+    atlas->flush(atlas->user);
+
+  memcpy(old, atlas->glyphs, sizeof(old));
+  memcpy(atlas->scratch, atlas->pixels, GLYPH_ATLAS_SIZE * GLYPH_ATLAS_SIZE * 4);
+  reset(atlas);
+  for (int i = 0; i < GLYPH_ATLAS_SLOTS; i++)
+  {
+    mu_Rectangle rect;
+    if (!old[i].used || old[i].last_used != atlas->frame)
+      continue;
+    if (!skyline_pack(atlas, old[i].rect.w + GLYPH_PADDING, old[i].rect.h + GLYPH_PADDING, &rect))
+      continue;
+    rect.w = old[i].rect.w;
+    rect.h = old[i].rect.h;
+    blit(atlas, rect, atlas->scratch + (old[i].rect.y * GLYPH_ATLAS_SIZE + old[i].rect.x) * 4, GLYPH_ATLAS_SIZE * 4);
+    Glyph *glyph = slot(atlas, old[i].codepoint);
+    *glyph = old[i];
+    glyph->rect = rect;
+    atlas->glyph_count++;
+  }
+  SDL_UpdateTexture(atlas->texture, NULL, atlas->pixels, GLYPH_ATLAS_SIZE * 4);
+}
+
+static const Glyph *add_glyph(GlyphAtlas *atlas, Uint32 codepoint)
+{
+  SDL_Color white = {255, 255, 255, 255};
+  SDL_Surface *rendered = TTF_RenderGlyph_Blended(atlas->font, codepoint, white);
+  if (!rendered)
+    return NULL;
+  SDL_Surface *surface = SDL_ConvertSurface(rendered, SDL_PIXELFORMAT_RGBA32);
+  SDL_DestroySurface(rendered);
+  if (!surface)
+    return NULL;
+
+  /* keep the table under 3/4 load and make room in the texture */
+  mu_Rectangle rect;
+  int w = surface->w, h = surface->h;
+  if ((atlas->glyph_count + 1) * 4 > GLYPH_ATLAS_SLOTS * 3 ||
+      !skyline_pack(atlas, w + GLYPH_PADDING, h + GLYPH_PADDING, &rect))
+  {
+    repack(atlas);
+    if (!skyline_pack(atlas, w + GLYPH_PADDING, h + GLYPH_PADDING, &rect))
+    {
+      SDL_DestroySurface(surface);
+      return NULL;
+    }
+  }
+  rect.w = w;
+  rect.h = h;
+  blit(atlas, rect, surface->pixels, surface->pitch);
+  SDL_UpdateTexture(atlas->texture, &(SDL_Rect){rect.x, rect.y, w, h}, surface->pixels, surface->pitch);
+  SDL_DestroySurface(surface);
+
+  int minx, maxx, miny, maxy, advance;
+  Glyph *glyph = slot(atlas, codepoint);
+  glyph->codepoint = codepoint;
+  glyph->used = 1;
+  glyph->rect = rect;
+  glyph->advance = TTF_GetGlyphMetrics(atlas->font, codepoint, &minx, &maxx, &miny, &maxy, &advance) ? advance : w;
+  atlas->glyph_count++;
+  return glyph;
+}
+
+/*============================================================================
+** atlas
+**============================================================================*/
+
+GlyphAtlas *glyph_atlas_create(SDL_Renderer *renderer, TTF_Font *font, void (*flush)(void *user), void *user)
+{
+  GlyphAtlas *atlas = calloc(1, sizeof(GlyphAtlas));
+  if (!atlas)
+    return NULL;
+  atlas->renderer = renderer;
+  atlas->font = font;
+  atlas->flush = flush;
+  atlas->user = user;
+  atlas->pixels = malloc(GLYPH_ATLAS_SIZE * GLYPH_ATLAS_SIZE * 4);
+  atlas->scratch = malloc(GLYPH_ATLAS_SIZE * GLYPH_ATLAS_SIZE * 4);
+  atlas->texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+                                     GLYPH_ATLAS_SIZE, GLYPH_ATLAS_SIZE);
+  if (!atlas->pixels || !atlas->scratch || !atlas->texture)
+  {
+    fprintf(stderr, "Failed to create glyph atlas: %s\n", SDL_GetError());
+    glyph_atlas_destroy(atlas);
+    return NULL;
+  }
+  SDL_SetTextureBlendMode(atlas->texture, SDL_BLENDMODE_BLEND);
+  SDL_SetTextureScaleMode(atlas->texture, SDL_SCALEMODE_NEAREST);
+  reset(atlas);
+  SDL_UpdateTexture(atlas->texture, NULL, atlas->pixels, GLYPH_ATLAS_SIZE * 4);
+  return atlas;
+}
+
+void glyph_atlas_destroy(GlyphAtlas *atlas)
+{
+  if (!atlas)
+    return;
+  if (atlas->texture)
+    SDL_DestroyTexture(atlas->texture);
+  free(atlas->pixels);
+  free(atlas->scratch);
+  free(atlas);
+}
+
+const Glyph *glyph_atlas_get(GlyphAtlas *atlas, Uint32 codepoint)
+{
+  Glyph *glyph = slot(atlas, codepoint);
+  if (!glyph->used)
+  {
+    glyph = (Glyph *)add_glyph(atlas, codepoint);
+    if (!glyph)
+      return NULL;
+  }
+  glyph->last_used = atlas->frame;
+  return glyph;
+}
+
+Uint32 glyph_atlas_decode(const char **text, const char *end)
+{
+  const unsigned char *p = (const unsigned char *)*text;
+  Uint32 codepoint = *p++;
+  int extra = codepoint >= 0xf0 ? 3 : codepoint >= 0xe0 ? 2 : codepoint >= 0xc0 ? 1 : 0;
+  codepoint &= extra ? 0x3f >> extra : 0xff;
+  while (extra-- && (const char *)p < end && (*p & 0xc0) == 0x80)
+    codepoint = (codepoint << 6) | (*p++ & 0x3f);
+  *text = (const char *)p;
+  return codepoint;
+}
+
+int glyph_atlas_text_width(GlyphAtlas *atlas, const char *text, int length)
+{
+  const char *end = text + (length < 0 ? (int)strlen(text) : length);
+  int width = 0;
+  while (text < end && *text)
+  {
+    const Glyph *glyph = glyph_atlas_get(atlas, glyph_atlas_decode(&text, end));
+    width += glyph ? glyph->advance : 0;
+  }
+  return width;
+}
+
+void glyph_atlas_next_frame(GlyphAtlas *atlas)
+{
+  atlas->frame++;
+}
@@ -1,21 +1,57 @@
 #include <SDL3/SDL.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "renderer.h"
 #include "microui.h"
+#include "microui_canvas.h"
+#include "microui_combobox.h"
+#include "microui_editor.h"
+#include "microui_log.h"
+#include "microui_textfield.h"
 
-static char logbuf[64000];
-static int logbuf_updated = 0;
+static char log_text[64000];
+static mu_LogLine log_lines[1024];
+static mu_Log log_view;
+static unsigned long long log_matches[1024];
+static mu_LogSearch log_search;
+static char input_text[4096];
+static int input_widths[sizeof(input_text)];
+static mu_TextField input;
+static char script_text[16384];
+static int script_lines[1024];
+static int script_states[1024];
+static mu_Editor script;
+static mu_CanvasItem plan_items[20000];
+static mu_CanvasCell plan_cells[1 << 15];
+static mu_Canvas plan;
+enum
+{
+  HOST_COUNT = 100000
+};
+static char host_text[HOST_COUNT][20];
+static const char *host_names[HOST_COUNT];
+static int host_order[HOST_COUNT];
+static mu_ComboBox host_picker;
 static float bg[3] = {90, 95, 100};
 
+enum
+{
+  HEATMAP_WIDTH = 128,
+  HEATMAP_HEIGHT = 64,
+  HEATMAP_INTERVAL = 50 /* ms per new row */
+};
+static unsigned char heatmap_pixels[HEATMAP_WIDTH * HEATMAP_HEIGHT * 4];
+static RendererImage *heatmap;
+static int heatmap_row;
+static int heatmap_next;
+static int bar_full;
+static long long bytes_sent = 9007199254740993LL;
+static double exposure = 0.1;
+
 static void write_log(const char *text)
 {
-  if (logbuf[0])
-  {
-    strcat(logbuf, "\n");
-  }
-  strcat(logbuf, text);
-  logbuf_updated = 1;
+  mu_log_append(&log_view, text, -1);
 }
 
 static void test_window(mu_Context *context)
@@ -41,6 +77,46 @@ static void test_window(mu_Context *context)
       mu_label(context, buffer);
     }
 
+    /* prefix search over every host name */
+    if (mu_header(context, "Host Picker"))
+    {
+      mu_layout_row(context, 2, (int[]){54, -1}, 0);
+      mu_label(context, "Host:");
+      if (mu_combobox(context, "Host List", &host_picker) & MU_RES_CHANGE)
+      {
+        char buffer[64];
+        sprintf(buffer, "Picked %s", host_names[host_picker.selected]);
+        write_log(buffer);
+      }
+    }
+
+    /* tweened bar; frames are only requested while it moves */
+    if (mu_header(context, "Animation"))
+    {
+      mu_Rectangle bar;
+      mu_Real fill;
+      mu_layout_row(context, 2, (int[]){54, -1}, 0);
+      if (mu_button(context, "Toggle"))
+      {
+        bar_full = !bar_full;
+      }
+      bar = mu_layout_next(context);
+      fill = mu_animate(context, mu_get_id(context, &bar_full, sizeof(bar_full)), bar, bar_full, 400);
+      context->draw_frame(context, bar, MU_COLOR_BASE);
+      mu_draw_rect(context, mu_rect(bar.x, bar.y, (int)(bar.w * fill), bar.h),
+                   context->style->colors[MU_COLOR_BUTTONHOVER]);
+    }
+
+    /* exact integer and double values, no float round-trip */
+    if (mu_header(context, "Typed Numbers"))
+    {
+      mu_layout_row(context, 2, (int[]){54, -1}, 0);
+      mu_label(context, "Bytes:");
+      mu_number_int64(context, &bytes_sent, 1);
+      mu_label(context, "Exposure:");
+      mu_slider_double_ex(context, &exposure, 0, 1, 0, "%.6f", MU_OPT_ALIGNCENTER);
+    }
+
     /* labels + buttons */
     if (mu_header_ex(context, "Test Buttons", MU_OPT_EXPANDED))
     {
@@ -165,26 +241,30 @@ static void test_window(mu_Context *context)
 
 static void log_window(mu_Context *context)
 {
-  if (mu_begin_window(context, "Log Window", mu_rect(350, 40, 300, 200)))
+  if (mu_begin_window(context, "Log Window", mu_rect(350, 40, 300, 240)))
   {
     /* output text panel */
-    mu_layout_row(context, 1, (int[]){-1}, -25);
+    mu_layout_row(context, 1, (int[]){-1}, -50);
     mu_begin_panel(context, "Log Output");
-    mu_Container *panel = mu_get_current_container(context);
-    mu_layout_row(context, 1, (int[]){-1}, -1);
-    mu_text(context, logbuf);
+    mu_log(context, &log_view);
     mu_end_panel(context);
-    if (logbuf_updated)
+
+    /* search textbox + next hit button */
+    static char pattern[MU_LOG_PATTERN_SIZE];
+    mu_layout_row(context, 2, (int[]){-70, -1}, 0);
+    if (mu_textbox(context, pattern, sizeof(pattern)) & MU_RES_CHANGE)
     {
-      panel->scroll.y = panel->content_size.y;
-      logbuf_updated = 0;
+      mu_log_search_set(&log_search, pattern);
+    }
+    if (mu_button(context, "Find"))
+    {
+      mu_log_search_next(&log_view, 1);
     }
 
-    /* input textbox + submit button */
-    static char buffer[128];
+    /* input field + submit button */
     int submitted = 0;
     mu_layout_row(context, 2, (int[]){-70, -1}, 0);
-    if (mu_textbox(context, buffer, sizeof(buffer)) & MU_RES_SUBMIT)
+    if (mu_textfield(context, &input) & MU_RES_SUBMIT)
     {
       mu_set_focus(context, context->last_identifier);
       submitted = 1;
@@ -195,8 +275,8 @@ static void log_window(mu_Context *context)
     }
     if (submitted)
     {
-      write_log(buffer);
-      buffer[0] = '\0';
+      write_log(input.buffer);
+      mu_textfield_set_text(&input, "", 0);
     }
 
     mu_end_window(context);
@@ -205,10 +285,10 @@ static void log_window(mu_Context *context)
 
 static int uint8_slider(mu_Context *context, unsigned char *value, int low, int high)
 {
-  static float tmp;
+  static int tmp;
   mu_push_id(context, &value, sizeof(value));
   tmp = *value;
-  int res = mu_slider_ex(context, &tmp, low, high, 0, "%.0f", MU_OPT_ALIGNCENTER);
+  int res = mu_slider_int(context, &tmp, low, high);
   *value = tmp;
   mu_pop_id(context);
   return res;
@@ -254,11 +334,179 @@ static void style_window(mu_Context *context)
   }
 }
 
+static void draw_gradient(void *handle, mu_Rectangle rectangle, void *user_data)
+{
+  /* app-rendered content: one vertex-colored quad straight through SDL */
+  Renderer *renderer = handle;
+  const float *tint = user_data;
+  float x0 = rectangle.x, y0 = rectangle.y;
+  float x1 = rectangle.x + rectangle.w, y1 = rectangle.y + rectangle.h;
+  SDL_FColor a = {tint[0] / 255, tint[1] / 255, tint[2] / 255, 1};
+  SDL_FColor b = {1 - a.r, 1 - a.g, 1 - a.b, 1};
+  SDL_Vertex vertices[4] = {
+      {{x0, y0}, a, {0, 0}},
+      {{x1, y0}, b, {0, 0}},
+      {{x1, y1}, a, {0, 0}},
+      {{x0, y1}, b, {0, 0}},
+  };
+  int indices[6] = {0, 1, 2, 0, 2, 3};
+  SDL_RenderGeometry(renderer->renderer, NULL, vertices, 4, indices, 6);
+}
+
+static void heatmap_window(mu_Context *context)
+{
+  /* write one new row per tick, spectrogram style; only it gets uploaded */
+  if (context->time - heatmap_next >= 0)
+  {
+    unsigned char *row = heatmap_pixels + heatmap_row * HEATMAP_WIDTH * 4;
+    for (int x = 0; x < HEATMAP_WIDTH; x++)
+    {
+      int v = (x * 7 + heatmap_row * 3 + rand() % 32) & 0xff;
+      row[x * 4 + 0] = v;
+      row[x * 4 + 1] = 64;
+      row[x * 4 + 2] = 255 - v;
+      row[x * 4 + 3] = 255;
+    }
+    renderer_mark_image_rows(heatmap, heatmap_row, 1);
+    heatmap_row = (heatmap_row + 1) % HEATMAP_HEIGHT;
+    heatmap_next = context->time + HEATMAP_INTERVAL;
+  }
+  mu_wake_at(context, heatmap_next);
+
+  if (mu_begin_window(context, "Heatmap", mu_rect(660, 40, 130, 120)))
+  {
+    mu_layout_row(context, 1, (int[]){-1}, -30);
+    mu_image(context, (mu_Texture)heatmap, mu_rect(0, 0, HEATMAP_WIDTH, HEATMAP_HEIGHT));
+    mu_layout_row(context, 1, (int[]){-1}, -1);
+    mu_draw_callback(context, mu_layout_next(context), draw_gradient, bg);
+    mu_end_window(context);
+  }
+}
+
+static void push_run(mu_TextRun *runs, int *count, int start, int end, mu_Color color)
+{
+  if (*count < MU_EDITOR_MAX_RUNS)
+  {
+    runs[(*count)++] = (mu_TextRun){start, end - start, color};
+  }
+}
+
+static int is_alpha(char c)
+{
+  return ((c | 0x20) >= 'a' && (c | 0x20) <= 'z') || c == '_';
+}
+
+/* C-like highlighting; the state is 1 inside a block comment */
+static int tokenize_script(void *user, int state, const char *text, int length, mu_TextRun *runs, int *run_count)
+{
+  static const char *keywords[] = {"if", "else", "for", "while", "return", "int", "float", NULL};
+  mu_Color comment = mu_color(110, 160, 110, 255), string = mu_color(220, 170, 100, 255);
+  mu_Color number = mu_color(170, 200, 240, 255), keyword = mu_color(200, 130, 220, 255);
+  int i = 0;
+  (void)user;
+  *run_count = 0;
+
+  while (i < length)
+  {
+    int start = i;
+    if (state == 1 || (text[i] == '/' && i + 1 < length && text[i + 1] == '*'))
+    {
+      /* block comment, possibly continued from an earlier line */
+      i += state == 1 ? 0 : 2;
+      state = 1;
+      while (i < length && state == 1)
+      {
+        if (text[i] == '*' && i + 1 < length && text[i + 1] == '/')
+        {
+          state = 0;
+          i++;
+        }
+        i++;
+      }
+      push_run(runs, run_count, start, i, comment);
+    }
+    else if (text[i] == '/' && i + 1 < length && text[i + 1] == '/')
+    {
+      push_run(runs, run_count, start, length, comment);
+      i = length;
+    }
+    else if (text[i] == '"')
+    {
+      while (++i < length && text[i] != '"')
+      {
+        i += text[i] == '\\';
+      }
+      i = mu_min(i + 1, length);
+      push_run(runs, run_count, start, i, string);
+    }
+    else if (text[i] >= '0' && text[i] <= '9')
+    {
+      while (i < length && ((text[i] >= '0' && text[i] <= '9') || text[i] == '.'))
+      {
+        i++;
+      }
+      push_run(runs, run_count, start, i, number);
+    }
+    else if (is_alpha(text[i]))
+    {
+      while (i < length && is_alpha(text[i]))
+      {
+        i++;
+      }
+      for (int k = 0; keywords[k]; k++)
+      {
+        if ((int)strlen(keywords[k]) == i - start && !memcmp(keywords[k], text + start, i - start))
+        {
+          push_run(runs, run_count, start, i, keyword);
+        }
+      }
+    }
+    else
+    {
+      i++;
+    }
+  }
+  return state;
+}
+
+static void script_window(mu_Context *context)
+{
+  if (mu_begin_window(context, "Script", mu_rect(350, 500, 440, 90)))
+  {
+    mu_layout_row(context, 1, (int[]){-1}, -1);
+    mu_begin_panel(context, "Script Text");
+    mu_editor(context, &script);
+    mu_end_panel(context);
+    mu_end_window(context);
+  }
+}
+
+static void plan_window(mu_Context *context)
+{
+  if (mu_begin_window(context, "Floor Plan", mu_rect(660, 170, 130, 320)))
+  {
+    /* only rooms in view are returned; drag to pan, wheel to zoom */
+    mu_layout_row(context, 1, (int[]){-1}, -1);
+    mu_begin_canvas(context, "Plan", &plan);
+    for (int i; (i = mu_canvas_next(&plan)) >= 0;)
+    {
+      mu_Color color = i == plan.hovered ? mu_color(240, 200, 90, 255)
+                                         : mu_color(60 + i % 7 * 20, 90 + i % 5 * 25, 120, 255);
+      mu_draw_rect(context, mu_canvas_rect(&plan, plan_items[i].bounds), color);
+    }
+    mu_end_canvas(context);
+    mu_end_window(context);
+  }
+}
+
 static void process_frame(mu_Context *context)
 {
   mu_begin(context);
+  heatmap_window(context);
   style_window(context);
   log_window(context);
+  script_window(context);
+  plan_window(context);
   test_window(context);
   mu_end(context);
 }
@@ -269,16 +517,42 @@ static const char button_map[256] = {
     [SDL_BUTTON_MIDDLE & 0xff] = MU_MOUSE_MIDDLE,
 };
 
-static const char key_map[256] = {
-    [SDLK_LSHIFT & 0xff] = MU_KEY_SHIFT,
-    [SDLK_RSHIFT & 0xff] = MU_KEY_SHIFT,
-    [SDLK_LCTRL & 0xff] = MU_KEY_CTRL,
-    [SDLK_RCTRL & 0xff] = MU_KEY_CTRL,
-    [SDLK_LALT & 0xff] = MU_KEY_ALT,
-    [SDLK_RALT & 0xff] = MU_KEY_ALT,
-    [SDLK_RETURN & 0xff] = MU_KEY_RETURN,
-    [SDLK_BACKSPACE & 0xff] = MU_KEY_BACKSPACE,
-};
+/* keycodes of non-ASCII keys are scancode | SDLK_SCANCODE_MASK, so they are
+** matched in full rather than folded into a byte-indexed table */
+static int key_map(SDL_Keycode key)
+{
+  switch (key)
+  {
+  case SDLK_LSHIFT:
+  case SDLK_RSHIFT:
+    return MU_KEY_SHIFT;
+  case SDLK_LCTRL:
+  case SDLK_RCTRL:
+    return MU_KEY_CTRL;
+  case SDLK_LALT:
+  case SDLK_RALT:
+    return MU_KEY_ALT;
+  case SDLK_RETURN:
+    return MU_KEY_RETURN;
+  case SDLK_BACKSPACE:
+    return MU_KEY_BACKSPACE;
+  case SDLK_LEFT:
+    return MU_KEY_LEFT;
+  case SDLK_RIGHT:
+    return MU_KEY_RIGHT;
+  case SDLK_UP:
+    return MU_KEY_UP;
+  case SDLK_DOWN:
+    return MU_KEY_DOWN;
+  case SDLK_HOME:
+    return MU_KEY_HOME;
+  case SDLK_END:
+    return MU_KEY_END;
+  case SDLK_DELETE:
+    return MU_KEY_DELETE;
+  }
+  return 0;
+}
 
 static int text_width(mu_Font font, const char *text, int length)
 {
@@ -298,8 +572,9 @@ static int text_height(mu_Font font)
 
 int main(int argc, char **argv)
 {
-  /* init SDL and renderer */
-  Renderer *renderer = renderer_init();
+  /* init SDL and renderer; --atlas-font skips SDL_ttf for the bitmap font */
+  int atlas_font = argc > 1 && strcmp(argv[1], "--atlas-font") == 0;
+  Renderer *renderer = renderer_init(atlas_font ? RENDERER_TEXT_ATLAS : RENDERER_TEXT_TTF);
 
   /* init microui */
   mu_Context *context = malloc(sizeof(mu_Context));
@@ -309,18 +584,44 @@ int main(int argc, char **argv)
   /* Use Renderer pointer as the font handle */
   context->style->font = (mu_Font)renderer;
 
+  mu_log_init(&log_view, log_text, sizeof(log_text), log_lines, sizeof(log_lines) / sizeof(*log_lines));
+  mu_log_search_init(&log_view, &log_search, log_matches, sizeof(log_matches) / sizeof(*log_matches));
+  mu_textfield_init(&input, input_text, sizeof(input_text), input_widths);
+  mu_editor_init(&script, script_text, sizeof(script_text), script_lines, sizeof(script_lines) / sizeof(*script_lines));
+  mu_editor_set_text(&script, "/* highlighted as you type */\nint total = 0;\nfor (int i = 0; i < 10; i++)\n  total += i; // sum\nprint(\"total\", total);\n", -1);
+  mu_editor_set_tokenizer(&script, tokenize_script, NULL, script_states);
+  mu_canvas_init(&plan, plan_items, sizeof(plan_items) / sizeof(*plan_items), plan_cells,
+                 sizeof(plan_cells) / sizeof(*plan_cells), 64);
+  for (int i = 0; i < (int)(sizeof(plan_items) / sizeof(*plan_items)); i++)
+  {
+    mu_canvas_add(&plan, mu_rect(i % 200 * 50, i / 200 * 40, 30 + i % 3 * 5, 25 + i % 4 * 3));
+  }
+  for (int i = 0; i < HOST_COUNT; i++)
+  {
+    static const char *roles[] = {"web", "db", "cache", "queue", "api"};
+    static const char *regions[] = {"eu", "us", "ap"};
+    sprintf(host_text[i], "%s-%s-%05d", roles[i % 5], regions[i / 5 % 3], i);
+    host_names[i] = host_text[i];
+  }
+  mu_combobox_init(&host_picker, host_names, host_order, HOST_COUNT);
+  heatmap = renderer_create_image(renderer, HEATMAP_WIDTH, HEATMAP_HEIGHT, heatmap_pixels);
+
   /* main loop */
   for (;;)
   {
-    /* handle SDL events */
+    /* handle SDL events, sleeping until one arrives or the UI wants a frame */
     SDL_Event e;
-    while (SDL_PollEvent(&e))
+    for (int ok = SDL_WaitEventTimeout(&e, context->frame ? mu_animation_timeout(context) : 0); ok;
+         ok = SDL_PollEvent(&e))
     {
       switch (e.type)
       {
       case SDL_EVENT_QUIT:
         exit(EXIT_SUCCESS);
         break;
+      case SDL_EVENT_RENDER_TARGETS_RESET:
+        renderer_invalidate_layers(renderer);
+        break;
       case SDL_EVENT_MOUSE_MOTION:
         mu_input_mousemove(context, e.motion.x, e.motion.y);
         break;
@@ -349,7 +650,7 @@ int main(int argc, char **argv)
       case SDL_EVENT_KEY_DOWN:
       case SDL_EVENT_KEY_UP:
       {
-        int c = key_map[e.key.key & 0xff];
+        int c = key_map(e.key.key);
         if (c && e.type == SDL_EVENT_KEY_DOWN)
         {
           mu_input_keydown(context, c);
@@ -364,28 +665,14 @@ int main(int argc, char **argv)
     }
 
     /* process frame */
+    mu_input_time(context, (int)SDL_GetTicks());
     process_frame(context);
 
     /* render */
     renderer_clear(renderer, mu_color(bg[0], bg[1], bg[2], 255));
-    mu_Command *command = NULL;
-    while (mu_next_command(context, &command))
+    for (int i = 0; i < context->root_list.idx; i++)
     {
-      switch (command->type)
-      {
-      case MU_COMMAND_TEXT:
-        renderer_draw_text(renderer, command->text.str, command->text.position, command->text.color);
-        break;
-      case MU_COMMAND_RECT:
-        renderer_draw_rect(renderer, command->rectangle.rectangle, command->rectangle.color);
-        break;
-      case MU_COMMAND_ICON:
-        renderer_draw_icon(renderer, command->icon.identifier, command->icon.rectangle, command->icon.color);
-        break;
-      case MU_COMMAND_CLIP:
-        renderer_set_clip_rect(renderer, command->clip.rectangle);
-        break;
-      }
+      renderer_draw_container(renderer, context->root_list.items[i]);
     }
     renderer_present(renderer);
   }
@@ -6,21 +6,8 @@
 #include <SDL3_ttf/SDL_ttf.h>
 
 #include "renderer.h"
-
-/* Atlas definitions for icons */
-enum
-{
-  ATLAS_WHITE = MU_ICON_MAX,
-  ATLAS_FONT
-};
-enum
-{
-  ATLAS_WIDTH = 128,
-  ATLAS_HEIGHT = 128
-};
-
-static unsigned char atlas_texture[ATLAS_WIDTH * ATLAS_HEIGHT];
-static mu_Rectangle atlas[256];
+#include "atlas_font.h"
+#include "glyph_atlas.h"
 
 /* System font paths for different platforms */
 static const char *font_paths[] = {
@@ -38,7 +25,12 @@ static const char *font_paths[] = {
     "C:\\Windows\\Fonts\\consola.ttf",
     NULL};
 
-Renderer *renderer_init(void)
+static void flush_batch(void *renderer)
+{
+  renderer_flush(renderer);
+}
+
+Renderer *renderer_init(RendererText text)
 {
   Renderer *renderer = malloc(sizeof(Renderer));
   if (!renderer)
@@ -53,6 +45,12 @@ Renderer *renderer_init(void)
   renderer->renderer = NULL;
   renderer->atlas_texture = NULL;
   renderer->font = NULL;
+  renderer->text = text;
+  renderer->glyphs = NULL;
+  renderer->batch_texture = NULL;
+  renderer->quad_count = 0;
+  renderer->origin = mu_vec2(0, 0);
+  memset(renderer->layers, 0, sizeof(renderer->layers));
 
   /* Initialize SDL */
   if (!SDL_Init(SDL_INIT_VIDEO))
@@ -83,7 +81,7 @@ Renderer *renderer_init(void)
 
   /* Load system font - try multiple paths */
   int font_size = 14;
-  for (int i = 0; font_paths[i] != NULL; i++)
+  for (int i = 0; renderer->text == RENDERER_TEXT_TTF && font_paths[i] != NULL; i++)
   {
     renderer->font = TTF_OpenFont(font_paths[i], font_size);
     if (renderer->font)
@@ -93,19 +91,30 @@ Renderer *renderer_init(void)
     }
   }
 
-  if (!renderer->font)
+  if (renderer->text == RENDERER_TEXT_TTF && !renderer->font)
   {
     fprintf(stderr, "Failed to load any system font. Tried:\n");
     for (int i = 0; font_paths[i] != NULL; i++)
     {
       fprintf(stderr, "  - %s\n", font_paths[i]);
     }
-    fprintf(stderr, "Error: %s\n", SDL_GetError());
-    free(renderer);
-    exit(1);
+    fprintf(stderr, "Falling back to the atlas font\n");
+    renderer->text = RENDERER_TEXT_ATLAS;
   }
 
-  /* Create texture from atlas data (for icons only) */
+  /* every quad is two triangles over its four vertices */
+  for (int i = 0; i < RENDERER_BATCH_QUADS; i++)
+  {
+    int *index = renderer->indices + i * 6;
+    index[0] = i * 4 + 0;
+    index[1] = i * 4 + 1;
+    index[2] = i * 4 + 2;
+    index[3] = i * 4 + 2;
+    index[4] = i * 4 + 3;
+    index[5] = i * 4 + 0;
+  }
+
+  /* Create texture from atlas data (glyphs, icons and the white texel) */
   unsigned char *rgba_data = malloc(ATLAS_WIDTH * ATLAS_HEIGHT * 4);
   for (int i = 0; i < ATLAS_WIDTH * ATLAS_HEIGHT; i++)
   {
@@ -122,6 +131,14 @@ Renderer *renderer_init(void)
   SDL_SetTextureScaleMode(renderer->atlas_texture, SDL_SCALEMODE_NEAREST);
 
   free(rgba_data);
+
+  /* TTF glyphs are rasterized on first use into a shared packed texture */
+  if (renderer->text == RENDERER_TEXT_TTF)
+  {
+    renderer->glyphs = glyph_atlas_create(renderer->renderer, renderer->font, flush_batch, renderer);
+    if (!renderer->glyphs)
+      renderer->text = RENDERER_TEXT_ATLAS;
+  }
   return renderer;
 }
 
@@ -130,6 +147,12 @@ void renderer_destroy(Renderer *renderer)
   if (!renderer)
     return;
 
+  glyph_atlas_destroy(renderer->glyphs);
+  for (int i = 0; i < RENDERER_LAYERS; i++)
+  {
+    if (renderer->layers[i].texture)
+      SDL_DestroyTexture(renderer->layers[i].texture);
+  }
   if (renderer->atlas_texture)
     SDL_DestroyTexture(renderer->atlas_texture);
   if (renderer->font)
@@ -144,43 +167,97 @@ void renderer_destroy(Renderer *renderer)
   free(renderer);
 }
 
-void renderer_draw_rect(Renderer *renderer, mu_Rectangle rectangle, mu_Color color)
+void renderer_flush(Renderer *renderer)
 {
-  SDL_FRect frect = {rectangle.x, rectangle.y, rectangle.w, rectangle.h};
-  SDL_SetRenderDrawColor(renderer->renderer, color.red, color.green, color.blue, color.alpha);
-  SDL_RenderFillRect(renderer->renderer, &frect);
+  if (renderer->quad_count == 0)
+    return;
+  SDL_RenderGeometry(renderer->renderer, renderer->batch_texture, renderer->vertices,
+                     renderer->quad_count * 4, renderer->indices, renderer->quad_count * 6);
+  renderer->quad_count = 0;
 }
 
-void renderer_draw_text(Renderer *renderer, const char *text, mu_Vector2 position, mu_Color color)
+/* queue a region of texture (size tw*th) drawn at dst, modulated by color */
+static void push_quad(Renderer *renderer, SDL_Texture *texture, int tw, int th,
+                      mu_Rectangle dst, mu_Rectangle src, mu_Color color)
 {
-  if (!renderer->font || !text || !*text)
-    return;
+  if (renderer->quad_count == RENDERER_BATCH_QUADS || texture != renderer->batch_texture)
+    renderer_flush(renderer);
+  renderer->batch_texture = texture;
+
+  SDL_Vertex *v = renderer->vertices + renderer->quad_count++ * 4;
+  dst.x -= renderer->origin.x;
+  dst.y -= renderer->origin.y;
+  float u0 = src.x / (float)tw, v0 = src.y / (float)th;
+  float u1 = (src.x + src.w) / (float)tw, v1 = (src.y + src.h) / (float)th;
+  SDL_FColor fcolor = {color.red / 255.0f, color.green / 255.0f, color.blue / 255.0f, color.alpha / 255.0f};
+  v[0] = (SDL_Vertex){{dst.x, dst.y}, fcolor, {u0, v0}};
+  v[1] = (SDL_Vertex){{dst.x + dst.w, dst.y}, fcolor, {u1, v0}};
+  v[2] = (SDL_Vertex){{dst.x + dst.w, dst.y + dst.h}, fcolor, {u1, v1}};
+  v[3] = (SDL_Vertex){{dst.x, dst.y + dst.h}, fcolor, {u0, v1}};
+}
 
-  /* Render text to surface using TTF */
-  SDL_Color sdl_color = {color.red, color.green, color.blue, color.alpha};
-  SDL_Surface *surface = TTF_RenderText_Blended(renderer->font, text, strlen(text), sdl_color);
-  if (!surface)
+void renderer_draw_rect(Renderer *renderer, mu_Rectangle rectangle, mu_Color color)
+{
+  /* both textures hold a white block: use whichever the batch is on so
+  ** rects never split a run of text */
+  if (renderer->glyphs && renderer->batch_texture == renderer->glyphs->texture)
   {
-    fprintf(stderr, "TTF_RenderText_Blended failed: %s\n", SDL_GetError());
+    push_quad(renderer, renderer->glyphs->texture, GLYPH_ATLAS_SIZE, GLYPH_ATLAS_SIZE,
+              rectangle, renderer->glyphs->white, color);
     return;
   }
+  /* sample the middle of the white block so filtering never reaches its edge */
+  mu_Rectangle white = atlas[ATLAS_WHITE];
+  push_quad(renderer, renderer->atlas_texture, ATLAS_WIDTH, ATLAS_HEIGHT,
+            rectangle, mu_rect(white.x + 1, white.y + 1, 1, 1), color);
+}
 
-  /* Create texture from surface */
-  SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer->renderer, surface);
-  if (!texture)
+void renderer_draw_lines(Renderer *renderer, const mu_Vector2 *points, int count, mu_Color color)
+{
+  /* convert in fixed-size batches; consecutive batches share an endpoint */
+  SDL_FPoint batch[256];
+  renderer_flush(renderer);
+  SDL_SetRenderDrawColor(renderer->renderer, color.red, color.green, color.blue, color.alpha);
+  for (int i = 0; i + 1 < count;)
   {
-    fprintf(stderr, "SDL_CreateTextureFromSurface failed: %s\n", SDL_GetError());
-    SDL_DestroySurface(surface);
-    return;
+    int n = mu_min(count - i, (int)(sizeof(batch) / sizeof(*batch)));
+    for (int j = 0; j < n; j++)
+    {
+      batch[j].x = points[i + j].x - renderer->origin.x;
+      batch[j].y = points[i + j].y - renderer->origin.y;
+    }
+    SDL_RenderLines(renderer->renderer, batch, n);
+    i += n - 1;
   }
+}
 
-  /* Render texture */
-  SDL_FRect dst_rect = {position.x, position.y, surface->w, surface->h};
-  SDL_RenderTexture(renderer->renderer, texture, NULL, &dst_rect);
+void renderer_draw_text(Renderer *renderer, const char *text, mu_Vector2 position, mu_Color color)
+{
+  if (renderer->text == RENDERER_TEXT_ATLAS)
+  {
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++)
+    {
+      if ((*p & 0xc0) == 0x80)
+        continue;
+      mu_Rectangle src = atlas_glyph(*p);
+      push_quad(renderer, renderer->atlas_texture, ATLAS_WIDTH, ATLAS_HEIGHT,
+                mu_rect(position.x, position.y, src.w, src.h), src, color);
+      position.x += src.w;
+    }
+    return;
+  }
 
-  /* Cleanup */
-  SDL_DestroyTexture(texture);
-  SDL_DestroySurface(surface);
+  /* one quad per glyph from the packed atlas; nothing is created per frame */
+  const char *end = text + strlen(text);
+  while (text < end)
+  {
+    const Glyph *glyph = glyph_atlas_get(renderer->glyphs, glyph_atlas_decode(&text, end));
+    if (!glyph)
+      continue;
+    push_quad(renderer, renderer->glyphs->texture, GLYPH_ATLAS_SIZE, GLYPH_ATLAS_SIZE,
+              mu_rect(position.x, position.y, glyph->rect.w, glyph->rect.h), glyph->rect, color);
+    position.x += glyph->advance;
+  }
 }
 
 void renderer_draw_icon(Renderer *renderer, int identifier, mu_Rectangle rectangle, mu_Color color)
@@ -189,44 +266,324 @@ void renderer_draw_icon(Renderer *renderer, int identifier, mu_Rectangle rectang
   int x = rectangle.x + (rectangle.w - src.w) / 2;
   int y = rectangle.y + (rectangle.h - src.h) / 2;
 
-  SDL_FRect src_rect = {src.x, src.y, src.w, src.h};
-  SDL_FRect dst_rect = {x, y, src.w, src.h};
+  push_quad(renderer, renderer->atlas_texture, ATLAS_WIDTH, ATLAS_HEIGHT,
+            mu_rect(x, y, src.w, src.h), src, color);
+}
+
+RendererImage *renderer_create_image(Renderer *renderer, int width, int height, const unsigned char *pixels)
+{
+  RendererImage *image = malloc(sizeof(RendererImage));
+  if (!image)
+  {
+    fprintf(stderr, "Failed to allocate RendererImage\n");
+    return NULL;
+  }
+
+  image->width = width;
+  image->height = height;
+  image->pixels = pixels;
+  image->texture = SDL_CreateTexture(renderer->renderer, SDL_PIXELFORMAT_RGBA32,
+                                     SDL_TEXTUREACCESS_STREAMING, width, height);
+  if (!image->texture)
+  {
+    fprintf(stderr, "SDL_CreateTexture failed: %s\n", SDL_GetError());
+    free(image);
+    return NULL;
+  }
+  SDL_SetTextureBlendMode(image->texture, SDL_BLENDMODE_BLEND);
+  SDL_SetTextureScaleMode(image->texture, SDL_SCALEMODE_NEAREST);
 
-  SDL_SetTextureColorMod(renderer->atlas_texture, color.red, color.green, color.blue);
-  SDL_SetTextureAlphaMod(renderer->atlas_texture, color.alpha);
-  SDL_RenderTexture(renderer->renderer, renderer->atlas_texture, &src_rect, &dst_rect);
+  /* everything needs uploading once */
+  image->dirty_top = 0;
+  image->dirty_bottom = height;
+  return image;
 }
 
-int renderer_get_text_width(Renderer *renderer, const char *text, int length)
+void renderer_destroy_image(RendererImage *image)
+{
+  if (!image)
+    return;
+
+  if (image->texture)
+    SDL_DestroyTexture(image->texture);
+  free(image);
+}
+
+void renderer_mark_image_rows(RendererImage *image, int first, int count)
+{
+  int last = mu_min(first + count, image->height);
+  first = mu_max(first, 0);
+  if (first >= last)
+    return;
+
+  if (image->dirty_top >= image->dirty_bottom)
+  {
+    image->dirty_top = first;
+    image->dirty_bottom = last;
+  }
+  else
+  {
+    image->dirty_top = mu_min(image->dirty_top, first);
+    image->dirty_bottom = mu_max(image->dirty_bottom, last);
+  }
+}
+
+void renderer_update_image(RendererImage *image)
+{
+  if (image->dirty_top >= image->dirty_bottom)
+    return;
+
+  /* upload only the band of rows touched since the last update */
+  int pitch = image->width * 4;
+  SDL_Rect rows = {0, image->dirty_top, image->width, image->dirty_bottom - image->dirty_top};
+  SDL_UpdateTexture(image->texture, &rows, image->pixels + image->dirty_top * pitch, pitch);
+  image->dirty_top = image->dirty_bottom = 0;
+}
+
+void renderer_draw_image(Renderer *renderer, RendererImage *image, mu_Rectangle source, mu_Rectangle rectangle, mu_Color color)
+{
+  /* deferred to draw time so hidden images never upload */
+  renderer_update_image(image);
+  renderer_flush(renderer);
+
+  SDL_FRect src_rect = {source.x, source.y, source.w, source.h};
+  SDL_FRect dst_rect = {rectangle.x - renderer->origin.x, rectangle.y - renderer->origin.y, rectangle.w, rectangle.h};
+
+  SDL_SetTextureColorMod(image->texture, color.red, color.green, color.blue);
+  SDL_SetTextureAlphaMod(image->texture, color.alpha);
+  SDL_RenderTexture(renderer->renderer, image->texture, &src_rect, &dst_rect);
+}
+
+void renderer_draw_callback(Renderer *renderer, mu_DrawCallback callback, mu_Rectangle rectangle, void *user_data)
 {
-  if (!renderer->font || !text || length == 0)
-    return 0;
+  /* callbacks talk to SDL directly; keep the clip state they may clobber */
+  SDL_Rect clip_rect;
+  renderer_flush(renderer);
+  int clipped = SDL_RenderClipEnabled(renderer->renderer);
+  if (clipped)
+    SDL_GetRenderClipRect(renderer->renderer, &clip_rect);
+
+  rectangle.x -= renderer->origin.x;
+  rectangle.y -= renderer->origin.y;
+  callback(renderer, rectangle, user_data);
+
+  SDL_SetRenderClipRect(renderer->renderer, clipped ? &clip_rect : NULL);
+}
 
-  /* Create a null-terminated string if length is specified */
-  char *temp = NULL;
-  if (length > 0 && length < strlen(text))
+static void draw_commands(Renderer *renderer, mu_Container *container)
+{
+  mu_Command *command = NULL;
+  while (mu_next_container_command(container, &command))
   {
-    temp = malloc(length + 1);
-    strncpy(temp, text, length);
-    temp[length] = '\0';
-    text = temp;
+    switch (command->type)
+    {
+    case MU_COMMAND_TEXT:
+      renderer_draw_text(renderer, command->text.str, command->text.position, command->text.color);
+      break;
+    case MU_COMMAND_RECT:
+      renderer_draw_rect(renderer, command->rectangle.rectangle, command->rectangle.color);
+      break;
+    case MU_COMMAND_ICON:
+      renderer_draw_icon(renderer, command->icon.identifier, command->icon.rectangle, command->icon.color);
+      break;
+    case MU_COMMAND_CLIP:
+      renderer_set_clip_rect(renderer, command->clip.rectangle);
+      break;
+    case MU_COMMAND_LINES:
+      for (int i = 0; i < command->lines.count; i += command->lines.run)
+      {
+        renderer_draw_lines(renderer, command->lines.points + i, command->lines.run, command->lines.color);
+      }
+      break;
+    case MU_COMMAND_IMAGE:
+      renderer_draw_image(renderer, command->image.texture, command->image.source, command->image.rectangle, command->image.color);
+      break;
+    case MU_COMMAND_CALLBACK:
+      renderer_draw_callback(renderer, command->callback.callback, command->callback.rectangle, command->callback.user_data);
+      break;
+    }
   }
+}
+
+/* FNV-1a */
+static unsigned hash_bytes(unsigned hash, const void *data, size_t size)
+{
+  const unsigned char *p = data;
+  while (size--)
+    hash = (hash ^ *p++) * 16777619u;
+  return hash;
+}
 
-  int width = 0;
-  int height = 0;
-  if (!TTF_GetStringSize(renderer->font, text, strlen(text), &width, &height))
+static unsigned hash_rect(unsigned hash, mu_Rectangle rectangle, mu_Vector2 origin)
+{
+  rectangle.x -= origin.x;
+  rectangle.y -= origin.y;
+  return hash_bytes(hash, &rectangle, sizeof(rectangle));
+}
+
+/* hash what the container's commands put on screen, with positions taken
+** relative to `origin` so a window that only moved hashes the same. sets
+** `dynamic` when the result also depends on something outside the commands:
+** an image with rows waiting to upload, or a callback that draws anything */
+static unsigned hash_commands(mu_Container *container, mu_Vector2 origin, int *dynamic)
+{
+  unsigned hash = 2166136261u;
+  mu_Command *command = NULL;
+  *dynamic = 0;
+  while (mu_next_container_command(container, &command))
   {
-    fprintf(stderr, "TTF_SizeText failed: %s\n", SDL_GetError());
-    width = 0;
+    hash = hash_bytes(hash, &command->type, sizeof(command->type));
+    switch (command->type)
+    {
+    case MU_COMMAND_TEXT:
+    {
+      mu_Vector2 position = mu_vec2(command->text.position.x - origin.x, command->text.position.y - origin.y);
+      hash = hash_bytes(hash, &command->text.font, sizeof(command->text.font));
+      hash = hash_bytes(hash, &position, sizeof(position));
+      hash = hash_bytes(hash, &command->text.color, sizeof(command->text.color));
+      hash = hash_bytes(hash, command->text.str, strlen(command->text.str));
+      break;
+    }
+    case MU_COMMAND_RECT:
+      hash = hash_rect(hash, command->rectangle.rectangle, origin);
+      hash = hash_bytes(hash, &command->rectangle.color, sizeof(command->rectangle.color));
+      break;
+    case MU_COMMAND_ICON:
+      hash = hash_rect(hash, command->icon.rectangle, origin);
+      hash = hash_bytes(hash, &command->icon.identifier, sizeof(command->icon.identifier));
+      hash = hash_bytes(hash, &command->icon.color, sizeof(command->icon.color));
+      break;
+    case MU_COMMAND_CLIP:
+      hash = hash_rect(hash, command->clip.rectangle, origin);
+      break;
+    case MU_COMMAND_LINES:
+      hash = hash_bytes(hash, &command->lines.color, sizeof(command->lines.color));
+      hash = hash_bytes(hash, &command->lines.run, sizeof(command->lines.run));
+      for (int i = 0; i < command->lines.count; i++)
+      {
+        mu_Vector2 point = mu_vec2(command->lines.points[i].x - origin.x, command->lines.points[i].y - origin.y);
+        hash = hash_bytes(hash, &point, sizeof(point));
+      }
+      break;
+    case MU_COMMAND_IMAGE:
+    {
+      RendererImage *image = command->image.texture;
+      hash = hash_bytes(hash, &command->image.texture, sizeof(command->image.texture));
+      hash = hash_rect(hash, command->image.source, mu_vec2(0, 0));
+      hash = hash_rect(hash, command->image.rectangle, origin);
+      hash = hash_bytes(hash, &command->image.color, sizeof(command->image.color));
+      *dynamic |= image->dirty_top < image->dirty_bottom;
+      break;
+    }
+    case MU_COMMAND_CALLBACK:
+      *dynamic = 1;
+      break;
+    }
   }
+  return hash;
+}
 
-  if (temp)
-    free(temp);
-  return width;
+/* the container's layer, (re)created at its current size; NULL if none is free */
+static RendererLayer *get_layer(Renderer *renderer, const mu_Container *container, int width, int height)
+{
+  RendererLayer *layer = NULL;
+  for (int i = 0; i < RENDERER_LAYERS && !layer; i++)
+  {
+    if (renderer->layers[i].key == container)
+      layer = &renderer->layers[i];
+  }
+  for (int i = 0; i < RENDERER_LAYERS && !layer; i++)
+  {
+    if (!renderer->layers[i].key)
+      layer = &renderer->layers[i];
+  }
+  if (!layer)
+    return NULL;
+
+  if (layer->texture && (layer->width != width || layer->height != height))
+  {
+    SDL_DestroyTexture(layer->texture);
+    layer->texture = NULL;
+  }
+  if (!layer->texture)
+  {
+    layer->texture = SDL_CreateTexture(renderer->renderer, SDL_PIXELFORMAT_RGBA32,
+                                       SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!layer->texture)
+    {
+      memset(layer, 0, sizeof(*layer));
+      return NULL;
+    }
+    /* drawing with BLEND over transparent black leaves premultiplied texels */
+    SDL_SetTextureBlendMode(layer->texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+    layer->width = width;
+    layer->height = height;
+    layer->drawn = 0;
+  }
+  layer->key = container;
+  return layer;
+}
+
+void renderer_draw_container(Renderer *renderer, mu_Container *container)
+{
+  /* the frame's border is drawn one pixel outside the container */
+  mu_Rectangle rectangle = container->rectangle;
+  rectangle = mu_rect(rectangle.x - 1, rectangle.y - 1, rectangle.w + 2, rectangle.h + 2);
+  RendererLayer *layer = NULL;
+  if (rectangle.w > 0 && rectangle.h > 0)
+    layer = get_layer(renderer, container, rectangle.w, rectangle.h);
+  if (!layer)
+  {
+    /* no layer to spare: draw straight to the screen as before */
+    draw_commands(renderer, container);
+    return;
+  }
+
+  /* only windows whose commands changed are drawn again */
+  int dynamic;
+  mu_Vector2 origin = mu_vec2(rectangle.x, rectangle.y);
+  unsigned hash = hash_commands(container, origin, &dynamic);
+  renderer_flush(renderer);
+  if (dynamic || !layer->drawn || layer->hash != hash)
+  {
+    SDL_SetRenderTarget(renderer->renderer, layer->texture);
+    SDL_SetRenderClipRect(renderer->renderer, NULL);
+    SDL_SetRenderDrawColor(renderer->renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer->renderer);
+    renderer->origin = origin;
+    draw_commands(renderer, container);
+    renderer_flush(renderer);
+    renderer->origin = mu_vec2(0, 0);
+    SDL_SetRenderTarget(renderer->renderer, NULL);
+    layer->hash = hash;
+    layer->drawn = 1;
+  }
+
+  /* anything else, moving included, is a single blit */
+  SDL_FRect dst_rect = {rectangle.x, rectangle.y, rectangle.w, rectangle.h};
+  SDL_SetRenderClipRect(renderer->renderer, NULL);
+  SDL_RenderTexture(renderer->renderer, layer->texture, NULL, &dst_rect);
+  layer->used = 1;
+}
+
+void renderer_invalidate_layers(Renderer *renderer)
+{
+  /* target contents are lost when the device resets */
+  for (int i = 0; i < RENDERER_LAYERS; i++)
+    renderer->layers[i].drawn = 0;
+}
+
+int renderer_get_text_width(Renderer *renderer, const char *text, int length)
+{
+  if (renderer->text == RENDERER_TEXT_ATLAS)
+    return atlas_text_width(text, length);
+  return glyph_atlas_text_width(renderer->glyphs, text, length);
 }
 
 int renderer_get_text_height(Renderer *renderer)
 {
+  if (renderer->text == RENDERER_TEXT_ATLAS)
+    return ATLAS_FONT_HEIGHT;
   if (!renderer->font)
     return 14;
   return TTF_GetFontHeight(renderer->font);
@@ -234,17 +591,34 @@ int renderer_get_text_height(Renderer *renderer)
 
 void renderer_set_clip_rect(Renderer *renderer, mu_Rectangle rectangle)
 {
-  SDL_Rect clip_rect = {rectangle.x, rectangle.y, rectangle.w, rectangle.h};
+  SDL_Rect clip_rect = {rectangle.x - renderer->origin.x, rectangle.y - renderer->origin.y, rectangle.w, rectangle.h};
+  renderer_flush(renderer);
   SDL_SetRenderClipRect(renderer->renderer, &clip_rect);
 }
 
 void renderer_clear(Renderer *renderer, mu_Color clr)
 {
+  renderer->quad_count = 0;
   SDL_SetRenderDrawColor(renderer->renderer, clr.red, clr.green, clr.blue, clr.alpha);
   SDL_RenderClear(renderer->renderer);
 }
 
 void renderer_present(Renderer *renderer)
 {
+  renderer_flush(renderer);
+  if (renderer->glyphs)
+    glyph_atlas_next_frame(renderer->glyphs);
   SDL_RenderPresent(renderer->renderer);
+
+  /* layers of containers that were not drawn this frame are closed windows */
+  for (int i = 0; i < RENDERER_LAYERS; i++)
+  {
+    RendererLayer *layer = &renderer->layers[i];
+    if (layer->key && !layer->used)
+    {
+      SDL_DestroyTexture(layer->texture);
+      memset(layer, 0, sizeof(*layer));
+    }
+    layer->used = 0;
+  }
 }
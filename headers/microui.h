@@ -30,6 +30,11 @@
 #ifndef MICROUI_H
 #define MICROUI_H
 
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
 /** @brief Version string for MicroUI */
 #define MU_VERSION "2.02"
 
@@ -54,6 +59,8 @@
 #define MU_CONTAINERPOOL_SIZE 48
 /** @brief Maximum number of retained tree node states */
 #define MU_TREENODEPOOL_SIZE 48
+/** @brief Maximum number of retained animations */
+#define MU_ANIMATIONPOOL_SIZE 32
 /** @brief Maximum number of column widths in a single layout row */
 #define MU_MAX_WIDTHS 16
 
@@ -109,6 +116,9 @@ enum
   MU_COMMAND_RECT,     /**< Draw filled rectangle */
   MU_COMMAND_TEXT,     /**< Draw text string */
   MU_COMMAND_ICON,     /**< Draw icon */
+  MU_COMMAND_LINES,    /**< Draw connected line segments */
+  MU_COMMAND_IMAGE,    /**< Draw a region of an app-owned texture */
+  MU_COMMAND_CALLBACK, /**< Invoke an app draw callback */
   MU_COMMAND_MAX       /**< Sentinel value */
 };
 
@@ -183,7 +193,14 @@ enum
   MU_KEY_CTRL = (1 << 1),      /**< Control key */
   MU_KEY_ALT = (1 << 2),       /**< Alt key */
   MU_KEY_BACKSPACE = (1 << 3), /**< Backspace key */
-  MU_KEY_RETURN = (1 << 4)     /**< Return/Enter key */
+  MU_KEY_RETURN = (1 << 4),    /**< Return/Enter key */
+  MU_KEY_LEFT = (1 << 5),      /**< Left arrow key */
+  MU_KEY_RIGHT = (1 << 6),     /**< Right arrow key */
+  MU_KEY_UP = (1 << 7),        /**< Up arrow key */
+  MU_KEY_DOWN = (1 << 8),      /**< Down arrow key */
+  MU_KEY_HOME = (1 << 9),      /**< Home key */
+  MU_KEY_END = (1 << 10),      /**< End key */
+  MU_KEY_DELETE = (1 << 11)    /**< Delete key */
 };
 
 /** @} */
@@ -197,6 +214,7 @@ typedef struct mu_Context mu_Context; /**< Forward declaration of UI context */
 typedef unsigned mu_Identifier;       /**< Widget unique identifier type */
 typedef MU_REAL mu_Real;              /**< Floating-point type for values */
 typedef void *mu_Font;                /**< Opaque font handle */
+typedef void *mu_Texture;             /**< Opaque backend texture handle */
 
 /** @brief 2D vector with integer coordinates */
 typedef struct
@@ -210,6 +228,13 @@ typedef struct
   int x, y, w, h;
 } mu_Rectangle;
 
+/** @brief App draw callback, invoked by the backend while iterating commands
+ * @param renderer Backend-specific renderer handle
+ * @param rectangle Area reserved for the callback
+ * @param user_data Pointer passed to mu_draw_callback()
+ */
+typedef void (*mu_DrawCallback)(void *renderer, mu_Rectangle rectangle, void *user_data);
+
 /** @brief RGBA color value */
 typedef struct
 {
@@ -223,6 +248,14 @@ typedef struct
   int last_update;
 } mu_PoolItem;
 
+/** @brief Retained tween between two values */
+typedef struct
+{
+  mu_Real from, to; /**< Start and end values */
+  int start;        /**< Time the tween starts (ms) */
+  int duration;     /**< Length of the tween (ms) */
+} mu_Animation;
+
 /* Command structures - for drawing commands generated by the UI */
 
 /** @brief Base command structure - shared by all command types */
@@ -272,6 +305,38 @@ typedef struct
   mu_Color color;
 } mu_IconCommand;
 
+/** @brief Polyline drawing command - points are stored inline
+ *
+ * The points form count / run separate polylines of `run` points each.
+ */
+typedef struct
+{
+  mu_BaseCommand base;
+  mu_Color color;
+  int count;
+  int run;
+  mu_Vector2 points[1];
+} mu_LinesCommand;
+
+/** @brief Image drawing command */
+typedef struct
+{
+  mu_BaseCommand base;
+  mu_Texture texture;     /**< Backend texture handle */
+  mu_Rectangle source;    /**< Region of the texture to draw */
+  mu_Rectangle rectangle; /**< Destination rectangle */
+  mu_Color color;         /**< Tint multiplied with the texels */
+} mu_ImageCommand;
+
+/** @brief Custom draw callback command */
+typedef struct
+{
+  mu_BaseCommand base;
+  mu_DrawCallback callback; /**< Function the backend invokes */
+  void *user_data;          /**< Passed through to the callback */
+  mu_Rectangle rectangle;   /**< Area reserved for the callback */
+} mu_CallbackCommand;
+
 /** @brief Union of all command types for polymorphic access */
 typedef union
 {
@@ -282,6 +347,9 @@ typedef union
   mu_RectCommand rectangle;
   mu_TextCommand text;
   mu_IconCommand icon;
+  mu_LinesCommand lines;
+  mu_ImageCommand image;
+  mu_CallbackCommand callback;
 } mu_Command;
 
 /** @brief Layout state - tracks positioning and sizing of widgets in a container */
@@ -371,6 +439,12 @@ struct mu_Context
   mu_Container *scroll_target;      /**< Container to receive scroll input */
   char number_edit_buf[MU_MAX_FMT]; /**< Buffer for number editing */
   mu_Identifier number_edit;        /**< ID of widget currently editing number */
+  int time;                         /**< Host clock in milliseconds (mu_input_time) */
+  mu_Rectangle animation_rect;      /**< Union of the rects animating this frame */
+  int animation_wake;               /**< Earliest time a frame is needed (if pending) */
+  int animation_pending;            /**< Non-zero if a frame is needed at animation_wake */
+  int input_received;               /**< Input arrived since the last mu_end */
+  mu_Identifier begin_focus;        /**< Focus at mu_begin, to tell if it moved */
 
   /* Stacks - for managing nested state */
   mu_stack(char, MU_COMMANDLIST_SIZE) command_list;                 /**< Drawing command buffer */
@@ -384,6 +458,8 @@ struct mu_Context
   mu_PoolItem container_pool[MU_CONTAINERPOOL_SIZE]; /**< Container state tracking */
   mu_Container containers[MU_CONTAINERPOOL_SIZE];    /**< Container objects */
   mu_PoolItem treenode_pool[MU_TREENODEPOOL_SIZE];   /**< Tree node state tracking */
+  mu_PoolItem animation_pool[MU_ANIMATIONPOOL_SIZE]; /**< Animation state tracking */
+  mu_Animation animations[MU_ANIMATIONPOOL_SIZE];    /**< Animation objects */
 
   /* Input state - updated by input callbacks */
   mu_Vector2 mouse_pos;      /**< Current mouse position */
@@ -524,6 +600,14 @@ mu_Container *mu_get_current_container(mu_Context *context);
  */
 mu_Container *mu_get_container(mu_Context *context, const char *name);
 
+/** @brief Get a container by a name of known length
+ * @param context UI context
+ * @param name Container name, not necessarily terminated
+ * @param length Length of `name` in bytes
+ * @return Container pointer or NULL
+ */
+mu_Container *mu_get_container_len(mu_Context *context, const char *name, int length);
+
 /** @brief Bring a container to front (highest z-index)
  * @param context UI context
  * @param cnt Container to bring to front
@@ -619,6 +703,59 @@ void mu_input_keyup(mu_Context *context, int key);
  */
 void mu_input_text(mu_Context *context, const char *text);
 
+/** @brief Report the current time, before mu_begin
+ * @param context UI context
+ * @param milliseconds Any monotonic millisecond clock
+ */
+void mu_input_time(mu_Context *context, int milliseconds);
+
+/** @} */
+
+/** @defgroup Animation Animation Functions
+ * @brief Tweened values that only need frames while they change
+ *
+ * Widgets ask for the current value of a tween each frame. After mu_end,
+ * `animation_rect` holds the union of the rects whose tweens moved this
+ * frame and mu_animation_timeout says how long the host may sleep before
+ * the next frame is needed, so nothing has to redraw continuously. Input,
+ * a new hover root or a focus change also ask for one more frame, since
+ * scrolling, dragging and hovering only show in the frame after them.
+ * @{
+ */
+
+/** @brief Get the current value of a tween towards `target`
+ *
+ * The first call for an identifier returns `target` as is. Whenever the
+ * target changes, a new tween starts from the current value after `delay`
+ * milliseconds and eases in and out over `duration` milliseconds.
+ *
+ * @param context UI context
+ * @param identifier Identifier of the tween
+ * @param rectangle Screen area that depends on the value
+ * @param target Value to move towards
+ * @param duration Length of the tween in milliseconds
+ * @param delay Time before the tween starts in milliseconds
+ * @return Current value
+ */
+mu_Real mu_animate_ex(mu_Context *context, mu_Identifier identifier, mu_Rectangle rectangle, mu_Real target,
+                      int duration, int delay);
+
+/** @brief Macro: Start tweens without a delay */
+#define mu_animate(context, identifier, rectangle, target, duration) \
+  mu_animate_ex(context, identifier, rectangle, target, duration, 0)
+
+/** @brief Ask for a frame at a given time, e.g. for the next sample of live data
+ * @param context UI context
+ * @param time Time in milliseconds on the mu_input_time clock
+ */
+void mu_wake_at(mu_Context *context, int time);
+
+/** @brief Milliseconds until the next frame is needed, after mu_end
+ * @param context UI context
+ * @return 0 to draw again right away, or -1 if nothing is pending
+ */
+int mu_animation_timeout(mu_Context *context);
+
 /** @} */
 
 /** @defgroup Commands Command Functions
@@ -641,6 +778,18 @@ mu_Command *mu_push_command(mu_Context *context, int type, int size);
  */
 int mu_next_command(mu_Context *context, mu_Command **command);
 
+/** @brief Get next drawing command of one root container
+ *
+ * Walks only the commands between the container's head and tail, skipping
+ * any root containers begun inside it. Valid after mu_end() for containers
+ * in the root list, so a backend can draw or cache each window separately.
+ *
+ * @param container Root container
+ * @param command Current command (NULL to get first)
+ * @return 1 if a valid command was retrieved, 0 if at end of the container
+ */
+int mu_next_container_command(mu_Container *container, mu_Command **command);
+
 /** @brief Set the clipping rectangle for subsequent drawing
  * @param context UI context
  * @param rectangle Clipping bounds
@@ -679,6 +828,53 @@ void mu_draw_text(mu_Context *context, mu_Font font, const char *str, int length
  */
 void mu_draw_icon(mu_Context *context, int identifier, mu_Rectangle rectangle, mu_Color color);
 
+/** @brief Queue a polyline to be drawn
+ *
+ * The points are copied into the command list and clipped once, as a whole,
+ * against the current clip rectangle.
+ *
+ * @param context UI context
+ * @param points Polyline vertices
+ * @param count Number of vertices
+ * @param color Line color
+ */
+void mu_draw_lines(mu_Context *context, const mu_Vector2 *points, int count, mu_Color color);
+
+/** @brief Queue several polylines of equal length as one command
+ *
+ * Draws count / run polylines, the first made of points[0..run), the next
+ * of points[run..2 * run), and so on.
+ *
+ * @param context UI context
+ * @param points Vertices of every polyline, back to back
+ * @param count Total number of vertices, a multiple of `run`
+ * @param run Vertices per polyline
+ * @param color Line color
+ */
+void mu_draw_polylines(mu_Context *context, const mu_Vector2 *points, int count, int run, mu_Color color);
+
+/** @brief Queue a region of a texture to be drawn
+ * @param context UI context
+ * @param texture Backend texture handle
+ * @param source Region of the texture to draw
+ * @param rectangle Destination rectangle (source is scaled to fit)
+ * @param color Tint color
+ */
+void mu_draw_image(mu_Context *context, mu_Texture texture, mu_Rectangle source, mu_Rectangle rectangle, mu_Color color);
+
+/** @brief Queue an app draw callback
+ *
+ * The callback runs during command iteration, in the same order as the
+ * surrounding commands, with the backend clip already set to the current
+ * clip rectangle when the area is partially visible.
+ *
+ * @param context UI context
+ * @param rectangle Area the callback draws into
+ * @param callback Function to invoke
+ * @param user_data Pointer passed through to the callback
+ */
+void mu_draw_callback(mu_Context *context, mu_Rectangle rectangle, mu_DrawCallback callback, void *user_data);
+
 /** @} */
 
 /** @defgroup Layout Layout Functions
@@ -729,6 +925,27 @@ void mu_layout_set_next(mu_Context *context, mu_Rectangle renderer, int relative
  */
 mu_Rectangle mu_layout_next(mu_Context *context);
 
+/** @brief Reserve a row tall enough for `count` fixed-height rows and find
+ * the ones inside the clip rect, so long lists only build what is visible
+ *
+ * Scrolling covers every row, since the full height is laid out.
+ *
+ * @param context UI context
+ * @param count Number of rows
+ * @param row_height Height of each row
+ * @param width Width of the reserved cell (negative = fill remaining space)
+ * @param padding Space above the first row and below the last
+ * @param first Receives the first visible row
+ * @param last Receives one past the last visible row
+ * @return Rectangle of the reserved cell; row i is at y + padding + i * row_height
+ */
+mu_Rectangle mu_layout_rows_ex(mu_Context *context, int count, int row_height, int width, int padding, int *first,
+                               int *last);
+
+/** @brief Macro: Reserve full-width rows without padding */
+#define mu_layout_rows(context, count, row_height, first, last) \
+  mu_layout_rows_ex(context, count, row_height, -1, 0, first, last)
+
 /** @} */
 
 /** @defgroup Control Control Functions
@@ -754,6 +971,17 @@ void mu_draw_control_frame(mu_Context *context, mu_Identifier identifier, mu_Rec
  */
 void mu_draw_control_text(mu_Context *context, const char *str, mu_Rectangle rectangle, int colorid, int opt);
 
+/** @brief Draw text of known length for a control
+ * @param context UI context
+ * @param str Text to draw
+ * @param length Length of `str` in bytes (-1 if terminated)
+ * @param rectangle Control bounds
+ * @param colorid Text color ID
+ * @param opt Options (MU_OPT_ALIGN*)
+ */
+void mu_draw_control_text_len(mu_Context *context, const char *str, int length, mu_Rectangle rectangle, int colorid,
+                              int opt);
+
 /** @brief Check if mouse is over a rectangle
  * @param context UI context
  * @param rectangle Rectangle to test
@@ -792,6 +1020,13 @@ void mu_text(mu_Context *context, const char *text);
  */
 void mu_label(mu_Context *context, const char *text);
 
+/** @brief Display a label of known length
+ * @param context UI context
+ * @param text Label text, not necessarily terminated
+ * @param length Length of `text` in bytes
+ */
+void mu_label_len(mu_Context *context, const char *text, int length);
+
 /** @brief Create a clickable button with extended options
  * @param context UI context
  * @param label Button text
@@ -801,6 +1036,16 @@ void mu_label(mu_Context *context, const char *text);
  */
 int mu_button_ex(mu_Context *context, const char *label, int icon, int opt);
 
+/** @brief Create a button with a label of known length
+ * @param context UI context
+ * @param label Button text, not necessarily terminated (NULL for none)
+ * @param length Length of `label` in bytes
+ * @param icon Optional icon ID (0 for none)
+ * @param opt Options (MU_OPT_*)
+ * @return Result flags (MU_RES_*)
+ */
+int mu_button_len(mu_Context *context, const char *label, int length, int icon, int opt);
+
 /** @brief Macro: Create a centered button
  * @param context UI context
  * @param label Button text
@@ -808,6 +1053,24 @@ int mu_button_ex(mu_Context *context, const char *label, int icon, int opt);
  */
 #define mu_button(context, label) mu_button_ex(context, label, 0, MU_OPT_ALIGNCENTER)
 
+/** @brief Display a texture region in the next layout cell
+ * @param context UI context
+ * @param texture Backend texture handle
+ * @param source Region of the texture to draw
+ * @param color Tint color
+ * @param opt Options (MU_OPT_*)
+ * @return MU_RES_SUBMIT if the image was clicked
+ */
+int mu_image_ex(mu_Context *context, mu_Texture texture, mu_Rectangle source, mu_Color color, int opt);
+
+/** @brief Macro: Display a texture region without tint
+ * @param context UI context
+ * @param texture Backend texture handle
+ * @param source Region of the texture to draw
+ * @return Result flags (MU_RES_*)
+ */
+#define mu_image(context, texture, source) mu_image_ex(context, texture, source, mu_color(255, 255, 255, 255), 0)
+
 /** @brief Create a checkbox for boolean state
  * @param context UI context
  * @param label Label text
@@ -883,6 +1146,90 @@ int mu_number_ex(mu_Context *context, mu_Real *value, mu_Real step, const char *
  */
 #define mu_number(context, value, step) mu_number_ex(context, value, step, MU_SLIDER_FMT, MU_OPT_ALIGNCENTER)
 
+/** @brief Create a slider over an int with integer step math
+ * @param context UI context
+ * @param value Pointer to value
+ * @param low Minimum value
+ * @param high Maximum value
+ * @param step Step size (0 or 1 for every integer)
+ * @param opt Options (MU_OPT_*)
+ * @return Result flags (MU_RES_*)
+ */
+int mu_slider_int_ex(mu_Context *context, int *value, int low, int high, int step, int opt);
+
+/** @brief Macro: Create a standard int slider */
+#define mu_slider_int(context, value, lo, hi) mu_slider_int_ex(context, value, lo, hi, 1, MU_OPT_ALIGNCENTER)
+
+/** @brief Create a number input over an int; dragging saturates at the int range
+ * @param context UI context
+ * @param value Pointer to value
+ * @param step Step per pixel of mouse drag
+ * @param opt Options (MU_OPT_*)
+ * @return Result flags (MU_RES_*)
+ */
+int mu_number_int_ex(mu_Context *context, int *value, int step, int opt);
+
+/** @brief Macro: Create a standard int number input */
+#define mu_number_int(context, value, step) mu_number_int_ex(context, value, step, MU_OPT_ALIGNCENTER)
+
+/** @brief Create a slider over a 64-bit integer, exact over the whole range
+ * @param context UI context
+ * @param value Pointer to value
+ * @param low Minimum value
+ * @param high Maximum value
+ * @param step Step size (0 or 1 for every integer)
+ * @param opt Options (MU_OPT_*)
+ * @return Result flags (MU_RES_*)
+ */
+int mu_slider_int64_ex(mu_Context *context, long long *value, long long low, long long high, long long step,
+                       int opt);
+
+/** @brief Macro: Create a standard 64-bit integer slider */
+#define mu_slider_int64(context, value, lo, hi) mu_slider_int64_ex(context, value, lo, hi, 1, MU_OPT_ALIGNCENTER)
+
+/** @brief Create a number input over a 64-bit integer; dragging saturates
+ * @param context UI context
+ * @param value Pointer to value
+ * @param step Step per pixel of mouse drag
+ * @param opt Options (MU_OPT_*)
+ * @return Result flags (MU_RES_*)
+ */
+int mu_number_int64_ex(mu_Context *context, long long *value, long long step, int opt);
+
+/** @brief Macro: Create a standard 64-bit integer number input */
+#define mu_number_int64(context, value, step) mu_number_int64_ex(context, value, step, MU_OPT_ALIGNCENTER)
+
+/** @brief Create a slider over a double without going through mu_Real
+ * @param context UI context
+ * @param value Pointer to value
+ * @param low Minimum value
+ * @param high Maximum value
+ * @param step Step size (0 for continuous)
+ * @param fmt Format string for value display
+ * @param opt Options (MU_OPT_*)
+ * @return Result flags (MU_RES_*)
+ */
+int mu_slider_double_ex(mu_Context *context, double *value, double low, double high, double step, const char *fmt,
+                        int opt);
+
+/** @brief Macro: Create a standard double slider */
+#define mu_slider_double(context, value, lo, hi) \
+  mu_slider_double_ex(context, value, lo, hi, 0, MU_SLIDER_FMT, MU_OPT_ALIGNCENTER)
+
+/** @brief Create a number input over a double without going through mu_Real
+ * @param context UI context
+ * @param value Pointer to value
+ * @param step Step per pixel of mouse drag
+ * @param fmt Format string for value display
+ * @param opt Options (MU_OPT_*)
+ * @return Result flags (MU_RES_*)
+ */
+int mu_number_double_ex(mu_Context *context, double *value, double step, const char *fmt, int opt);
+
+/** @brief Macro: Create a standard double number input */
+#define mu_number_double(context, value, step) \
+  mu_number_double_ex(context, value, step, MU_SLIDER_FMT, MU_OPT_ALIGNCENTER)
+
 /** @brief Create a collapsible header with extended options
  * @param context UI context
  * @param label Header text
@@ -891,6 +1238,15 @@ int mu_number_ex(mu_Context *context, mu_Real *value, mu_Real step, const char *
  */
 int mu_header_ex(mu_Context *context, const char *label, int opt);
 
+/** @brief Create a header with a label of known length
+ * @param context UI context
+ * @param label Header text, not necessarily terminated
+ * @param length Length of `label` in bytes
+ * @param opt Options (MU_OPT_*)
+ * @return MU_RES_ACTIVE if expanded
+ */
+int mu_header_len(mu_Context *context, const char *label, int length, int opt);
+
 /** @brief Macro: Create a standard header
  * @param context UI context
  * @param label Header text
@@ -906,6 +1262,15 @@ int mu_header_ex(mu_Context *context, const char *label, int opt);
  */
 int mu_begin_treenode_ex(mu_Context *context, const char *label, int opt);
 
+/** @brief Create a tree node with a label of known length
+ * @param context UI context
+ * @param label Node label, not necessarily terminated
+ * @param length Length of `label` in bytes
+ * @param opt Options (MU_OPT_*)
+ * @return MU_RES_ACTIVE if expanded
+ */
+int mu_begin_treenode_len(mu_Context *context, const char *label, int length, int opt);
+
 /** @brief Macro: Create a standard tree node
  * @param context UI context
  * @param label Node label
@@ -927,6 +1292,16 @@ void mu_end_treenode(mu_Context *context);
  */
 int mu_begin_window_ex(mu_Context *context, const char *title, mu_Rectangle rectangle, int opt);
 
+/** @brief Begin a window with a title of known length
+ * @param context UI context
+ * @param title Window title, not necessarily terminated
+ * @param length Length of `title` in bytes
+ * @param rectangle Window bounds
+ * @param opt Options (MU_OPT_*)
+ * @return MU_RES_ACTIVE if window is open
+ */
+int mu_begin_window_len(mu_Context *context, const char *title, int length, mu_Rectangle rectangle, int opt);
+
 /** @brief Macro: Create a standard window
  * @param context UI context
  * @param title Window title
@@ -965,6 +1340,14 @@ void mu_end_popup(mu_Context *context);
  */
 void mu_begin_panel_ex(mu_Context *context, const char *name, int opt);
 
+/** @brief Begin a panel with a name of known length
+ * @param context UI context
+ * @param name Panel name, not necessarily terminated
+ * @param length Length of `name` in bytes
+ * @param opt Options (MU_OPT_*)
+ */
+void mu_begin_panel_len(mu_Context *context, const char *name, int length, int opt);
+
 /** @brief Macro: Create a standard panel
  * @param context UI context
  * @param name Panel name
@@ -978,4 +1361,8 @@ void mu_end_panel(mu_Context *context);
 
 /** @} */
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif
@@ -0,0 +1,213 @@
+/**
+ * @file microui.hpp
+ * @brief Header-only C++17 wrapper over the MicroUI core
+ *
+ * Scopes that the C API opens and closes by hand (windows, popups, panels,
+ * tree nodes, columns and ID pushes) become RAII guards that test as bool
+ * and close themselves when they go out of scope. Strings are taken as
+ * std::string_view and their lengths passed straight to the core's `_len`
+ * entry points, so no call measures its label again. Option flags are
+ * template parameters; everything is inline forwarding, compiling to the
+ * same calls hand-written C would make.
+ *
+ * @code
+ * if (mu::Window window{context, "Demo", mu_rect(40, 40, 300, 450)})
+ * {
+ *   if (mu::header<MU_OPT_EXPANDED>(context, "Buttons"))
+ *   {
+ *     if (mu::button(context, name)) { ... }
+ *   }
+ * }
+ * @endcode
+ */
+
+#ifndef MICROUI_HPP
+#define MICROUI_HPP
+
+#include <string_view>
+
+#include "microui.h"
+
+namespace mu
+{
+
+/** @brief Length of a string view as the core expects it */
+inline int length(std::string_view text)
+{
+  return static_cast<int>(text.size());
+}
+
+/*============================================================================
+** widgets
+**============================================================================*/
+
+/** @brief Display a label */
+inline void label(mu_Context *context, std::string_view text)
+{
+  mu_label_len(context, text.data(), length(text));
+}
+
+/** @brief Create a button; an empty label with no data uses the icon as ID
+ * @tparam Opt Options (MU_OPT_*)
+ * @return Result flags (MU_RES_*)
+ */
+template <int Opt = MU_OPT_ALIGNCENTER>
+inline int button(mu_Context *context, std::string_view label, int icon = 0)
+{
+  return mu_button_len(context, label.data(), length(label), icon, Opt);
+}
+
+/** @brief Create a collapsible header
+ * @tparam Opt Options (MU_OPT_*)
+ * @return Non-zero if expanded
+ */
+template <int Opt = 0>
+inline int header(mu_Context *context, std::string_view label)
+{
+  return mu_header_len(context, label.data(), length(label), Opt) & MU_RES_ACTIVE;
+}
+
+/*============================================================================
+** scopes
+**============================================================================*/
+
+/** @brief Window scope, ended on destruction if it was open
+ * @tparam Opt Options (MU_OPT_*)
+ */
+template <int Opt = 0>
+class Window
+{
+public:
+  Window(mu_Context *context, std::string_view title, mu_Rectangle rectangle)
+      : context_(context), open_(mu_begin_window_len(context, title.data(), length(title), rectangle, Opt))
+  {
+  }
+  ~Window()
+  {
+    if (open_)
+    {
+      mu_end_window(context_);
+    }
+  }
+  Window(const Window &) = delete;
+  Window &operator=(const Window &) = delete;
+
+  /** @brief Whether the window is open and its contents should be built */
+  explicit operator bool() const
+  {
+    return open_ != 0;
+  }
+
+private:
+  mu_Context *context_;
+  int open_;
+};
+
+/** @brief Popup scope, opened elsewhere with mu_open_popup */
+class Popup : public Window<MU_OPT_POPUP | MU_OPT_AUTOSIZE | MU_OPT_NORESIZE | MU_OPT_NOSCROLL |
+                            MU_OPT_NOTITLE | MU_OPT_CLOSED>
+{
+public:
+  Popup(mu_Context *context, std::string_view name) : Window(context, name, mu_rect(0, 0, 0, 0))
+  {
+  }
+};
+
+/** @brief Panel scope in the next layout cell
+ * @tparam Opt Options (MU_OPT_*)
+ */
+template <int Opt = 0>
+class Panel
+{
+public:
+  Panel(mu_Context *context, std::string_view name) : context_(context)
+  {
+    mu_begin_panel_len(context, name.data(), length(name), Opt);
+  }
+  ~Panel()
+  {
+    mu_end_panel(context_);
+  }
+  Panel(const Panel &) = delete;
+  Panel &operator=(const Panel &) = delete;
+
+private:
+  mu_Context *context_;
+};
+
+/** @brief Tree node scope, ended on destruction if it was expanded
+ * @tparam Opt Options (MU_OPT_*)
+ */
+template <int Opt = 0>
+class TreeNode
+{
+public:
+  TreeNode(mu_Context *context, std::string_view label)
+      : context_(context), expanded_(mu_begin_treenode_len(context, label.data(), length(label), Opt))
+  {
+  }
+  ~TreeNode()
+  {
+    if (expanded_)
+    {
+      mu_end_treenode(context_);
+    }
+  }
+  TreeNode(const TreeNode &) = delete;
+  TreeNode &operator=(const TreeNode &) = delete;
+
+  /** @brief Whether the node is expanded and its children should be built */
+  explicit operator bool() const
+  {
+    return expanded_ != 0;
+  }
+
+private:
+  mu_Context *context_;
+  int expanded_;
+};
+
+/** @brief Column scope: nested layout in the next cell */
+class Column
+{
+public:
+  explicit Column(mu_Context *context) : context_(context)
+  {
+    mu_layout_begin_column(context);
+  }
+  ~Column()
+  {
+    mu_layout_end_column(context_);
+  }
+  Column(const Column &) = delete;
+  Column &operator=(const Column &) = delete;
+
+private:
+  mu_Context *context_;
+};
+
+/** @brief ID scope: widgets inside get IDs unique to `data` */
+class Id
+{
+public:
+  Id(mu_Context *context, const void *data, int size) : context_(context)
+  {
+    mu_push_id(context, data, size);
+  }
+  Id(mu_Context *context, std::string_view name) : Id(context, name.data(), length(name))
+  {
+  }
+  ~Id()
+  {
+    mu_pop_id(context_);
+  }
+  Id(const Id &) = delete;
+  Id &operator=(const Id &) = delete;
+
+private:
+  mu_Context *context_;
+};
+
+} // namespace mu
+
+#endif
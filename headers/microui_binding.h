@@ -0,0 +1,137 @@
+/**
+ * @file microui_binding.h
+ * @brief Lock-free live data binding for values fed by producer threads
+ *
+ * A binding slot is written by one producer thread and read by the UI thread
+ * through a sequence lock. The producer never blocks, and the UI thread never
+ * waits on the producer: if a consistent snapshot cannot be taken within
+ * MU_BINDING_RETRIES attempts, the previous snapshot is kept for this frame.
+ *
+ * Each slot carries a version that only changes when the UI side observed a
+ * new value, so callers can tell whether a widget's displayed value changed.
+ */
+
+#ifndef MICROUI_BINDING_H
+#define MICROUI_BINDING_H
+
+#include <stdatomic.h>
+
+#include "microui.h"
+
+/** @defgroup Binding Live Data Binding
+ * @brief Seqlock-protected slots shared between producer threads and the UI
+ * @{
+ */
+
+/** @brief Size of a binding payload in bytes (multiple of 8) */
+#define MU_BINDING_SIZE 64
+/** @brief Number of snapshot attempts per sync before keeping the old value */
+#define MU_BINDING_RETRIES 4
+
+/** @brief Value of a binding as seen by the UI thread */
+typedef union
+{
+  mu_Real real;                                      /**< Numeric value */
+  char text[MU_BINDING_SIZE];                        /**< Null-terminated text */
+  unsigned long long words[MU_BINDING_SIZE / 8];     /**< Raw payload words */
+} mu_BindingValue;
+
+/** @brief Binding slot - one producer thread, one UI reader
+ *
+ * The producer and reader halves live on separate cache lines so that
+ * publishing does not invalidate the reader's snapshot on every write.
+ */
+typedef struct
+{
+  /* Producer side - written by mu_binding_publish() */
+  atomic_uint sequence;                                /**< Odd while a write is in progress */
+  atomic_ullong payload[MU_BINDING_SIZE / 8];          /**< Published words */
+
+  /* Reader side - only touched by the UI thread */
+  _Alignas(64) unsigned seen; /**< Sequence of the last consistent snapshot */
+  unsigned version;           /**< Incremented whenever the snapshot changes */
+  mu_BindingValue value;      /**< Last consistent snapshot */
+} mu_Binding;
+
+/** @brief Initialize a binding slot to zero
+ * @param binding Slot to initialize
+ */
+void mu_binding_init(mu_Binding *binding);
+
+/** @brief Publish raw bytes into a slot (producer thread)
+ * @param binding Slot to write
+ * @param data Data to copy
+ * @param size Size of data (at most MU_BINDING_SIZE)
+ */
+void mu_binding_publish(mu_Binding *binding, const void *data, int size);
+
+/** @brief Publish a numeric value into a slot (producer thread)
+ * @param binding Slot to write
+ * @param value Value to publish
+ */
+void mu_binding_publish_real(mu_Binding *binding, mu_Real value);
+
+/** @brief Publish a text value into a slot (producer thread)
+ * @param binding Slot to write
+ * @param text Text to publish (truncated to MU_BINDING_SIZE - 1 bytes)
+ */
+void mu_binding_publish_text(mu_Binding *binding, const char *text);
+
+/** @brief Take a snapshot of the slot without blocking (UI thread)
+ * @param binding Slot to read
+ * @return 1 if the snapshot changed, 0 otherwise
+ */
+int mu_binding_sync(mu_Binding *binding);
+
+/** @brief Check whether a slot changed since a previously seen version
+ * @param binding Slot to check
+ * @param version Version seen by the caller; updated to the current version
+ * @return 1 if the version differs, 0 otherwise
+ */
+int mu_binding_changed(mu_Binding *binding, unsigned *version);
+
+/** @brief Slider over a bound value
+ *
+ * The snapshot is not refreshed while the slider is focused, so dragging is
+ * not fought by the producer. When the user changes the value MU_RES_CHANGE
+ * is returned and the new value is left in `binding->value.real`.
+ *
+ * @param context UI context
+ * @param binding Slot to display
+ * @param low Minimum value
+ * @param high Maximum value
+ * @param step Step size (0 for continuous)
+ * @param fmt Format string for value display
+ * @param opt Options (MU_OPT_*)
+ * @return Result flags (MU_RES_*)
+ */
+int mu_bound_slider_ex(mu_Context *context, mu_Binding *binding, mu_Real low, mu_Real high, mu_Real step, const char *fmt, int opt);
+
+/** @brief Macro: Create a standard slider over a bound value */
+#define mu_bound_slider(context, binding, lo, hi) mu_bound_slider_ex(context, binding, lo, hi, 0, MU_SLIDER_FMT, MU_OPT_ALIGNCENTER)
+
+/** @brief Number input over a bound value
+ *
+ * Same refresh rules as mu_bound_slider_ex().
+ *
+ * @param context UI context
+ * @param binding Slot to display
+ * @param step Step size for mouse drag adjustment
+ * @param fmt Format string for value display
+ * @param opt Options (MU_OPT_*)
+ * @return Result flags (MU_RES_*)
+ */
+int mu_bound_number_ex(mu_Context *context, mu_Binding *binding, mu_Real step, const char *fmt, int opt);
+
+/** @brief Macro: Create a standard number input over a bound value */
+#define mu_bound_number(context, binding, step) mu_bound_number_ex(context, binding, step, MU_SLIDER_FMT, MU_OPT_ALIGNCENTER)
+
+/** @brief Label showing a bound text value
+ * @param context UI context
+ * @param binding Slot published with mu_binding_publish_text()
+ */
+void mu_bound_label(mu_Context *context, mu_Binding *binding);
+
+/** @} */
+
+#endif
@@ -0,0 +1,161 @@
+/**
+ * @file microui_canvas.h
+ * @brief Pan/zoom canvas with a spatial index of user items
+ *
+ * A canvas is a panel with its own transform: dragging pans it and the
+ * mouse wheel zooms around the cursor. The app registers the world bounds
+ * of its items once; they are bucketed in a hashed grid keyed by the cell
+ * holding each item's top-left corner, with every cell remembering the
+ * union of its items' bounds. Each frame the canvas walks only the cells
+ * near the visible region and hands the app the items that intersect it,
+ * and mouse hit-testing goes through the same index, so frame cost follows
+ * the number of visible items rather than the total.
+ */
+
+#ifndef MICROUI_CANVAS_H
+#define MICROUI_CANVAS_H
+
+#include "microui.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @defgroup Canvas Canvas
+ * @brief Culled drawing of large 2D scenes
+ * @{
+ */
+
+/** @brief Zoom limits */
+#define MU_CANVAS_MIN_ZOOM (1.0f / 64)
+#define MU_CANVAS_MAX_ZOOM 64.0f
+
+/** @brief A registered item */
+typedef struct
+{
+  mu_Rectangle bounds; /**< World bounds */
+  int cell;            /**< Slot of the grid cell holding the item */
+  int prev;            /**< Previous item in the cell (-1 for none) */
+  int next;            /**< Next item in the cell (-1 for none) */
+} mu_CanvasItem;
+
+/** @brief A grid cell, stored in an open-addressed hash table */
+typedef struct
+{
+  int x, y;            /**< Cell coordinates */
+  int used;            /**< 0 for a free slot, 1 for a new cell, 2 once `bounds` is set */
+  int first;           /**< First item (-1 for none) */
+  mu_Rectangle bounds; /**< Union of every item ever placed in the cell */
+} mu_CanvasCell;
+
+/** @brief Iteration over the items intersecting a world rectangle */
+typedef struct
+{
+  mu_Rectangle rectangle; /**< World rectangle being queried */
+  int x1, y1, x2, y2;     /**< Cell range to visit */
+  int cx, cy;             /**< Current cell when walking the range */
+  int slot;               /**< Current slot when scanning the whole table */
+  int scan;               /**< Non-zero to scan the table instead of the range */
+  int item;               /**< Next item to test (-1 to advance to the next cell) */
+} mu_CanvasQuery;
+
+/** @brief Retained canvas state */
+typedef struct
+{
+  mu_CanvasItem *items; /**< Item storage */
+  int item_capacity;    /**< Slots in `items` */
+  int item_count;       /**< Registered items */
+  mu_CanvasCell *cells; /**< Hash table storage */
+  int cell_capacity;    /**< Slots in `cells` (power of two) */
+  int cell_count;       /**< Slots in use */
+  int cell_size;        /**< Grid cell size in world units */
+  int max_w, max_h;     /**< Largest item size, how far to look behind a cell */
+
+  mu_Real pan_x, pan_y; /**< World point at the top-left of the view */
+  mu_Real zoom;         /**< Screen pixels per world unit */
+  mu_Rectangle body;    /**< Screen rectangle of the view this frame */
+  int hovered;          /**< Topmost item under the mouse this frame (-1 for none) */
+  mu_CanvasQuery visible; /**< Iteration used by mu_canvas_next */
+} mu_Canvas;
+
+/** @brief Initialize an empty canvas over app storage
+ * @param canvas Canvas to initialize
+ * @param items Storage for items
+ * @param item_capacity Slots in `items`
+ * @param cells Storage for grid cells
+ * @param cell_capacity Slots in `cells`, a power of two
+ * @param cell_size Grid cell size in world units, around the typical item size
+ */
+void mu_canvas_init(mu_Canvas *canvas, mu_CanvasItem *items, int item_capacity, mu_CanvasCell *cells,
+                    int cell_capacity, int cell_size);
+
+/** @brief Remove every item, keeping the view */
+void mu_canvas_clear(mu_Canvas *canvas);
+
+/** @brief Register an item
+ * @param canvas Canvas to modify
+ * @param bounds World bounds
+ * @return Item index, or -1 if the items or cells are full
+ */
+int mu_canvas_add(mu_Canvas *canvas, mu_Rectangle bounds);
+
+/** @brief Change the bounds of an item
+ * @param canvas Canvas to modify
+ * @param item Item index
+ * @param bounds New world bounds
+ * @return 1 on success, 0 if the item's new cell does not fit
+ */
+int mu_canvas_move(mu_Canvas *canvas, int item, mu_Rectangle bounds);
+
+/** @brief Start iterating the items intersecting a world rectangle */
+void mu_canvas_query(mu_Canvas *canvas, mu_CanvasQuery *query, mu_Rectangle rectangle);
+
+/** @brief Get the next item of a query, in no particular order
+ * @return Item index, or -1 when done
+ */
+int mu_canvas_query_next(mu_Canvas *canvas, mu_CanvasQuery *query);
+
+/** @brief Find the item with the highest index containing a world point
+ * @return Item index, or -1 for none
+ */
+int mu_canvas_hit(mu_Canvas *canvas, mu_Vector2 point);
+
+/** @brief Map a world rectangle to the screen with the current transform */
+mu_Rectangle mu_canvas_rect(mu_Canvas *canvas, mu_Rectangle world);
+
+/** @brief Map a screen point to the world with the current transform */
+mu_Vector2 mu_canvas_point(mu_Canvas *canvas, mu_Vector2 screen);
+
+/** @brief Begin a canvas in the next layout cell
+ *
+ * Handles panning and zooming, then starts the iteration over visible
+ * items; call mu_canvas_next until it returns -1 and draw each item at
+ * mu_canvas_rect of its bounds. Wheel input over the canvas is consumed.
+ *
+ * @param context UI context
+ * @param name Panel name
+ * @param canvas Canvas to draw
+ * @param opt Options (MU_OPT_*)
+ * @return MU_RES_CHANGE if the view moved
+ */
+int mu_begin_canvas_ex(mu_Context *context, const char *name, mu_Canvas *canvas, int opt);
+
+/** @brief Macro: Begin a canvas with default options */
+#define mu_begin_canvas(context, name, canvas) mu_begin_canvas_ex(context, name, canvas, 0)
+
+/** @brief Get the next visible item
+ * @return Item index, or -1 when every visible item has been returned
+ */
+int mu_canvas_next(mu_Canvas *canvas);
+
+/** @brief End a canvas */
+void mu_end_canvas(mu_Context *context);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * @file microui_chart.h
+ * @brief Time-series chart widget with per-column min/max decimation
+ *
+ * Samples live in an app-owned ring buffer (mu_Series). The chart reduces the
+ * visible sample window to one min/max pair per pixel column and emits the
+ * trace as a single polyline command, whatever the number of samples. The
+ * decimated columns are cached in the mu_Chart state and only recomputed
+ * when the series version, the width or the view changes.
+ */
+
+#ifndef MICROUI_CHART_H
+#define MICROUI_CHART_H
+
+#include "microui.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @defgroup Chart Chart Widget
+ * @brief Decimated time-series plots over ring-buffered samples
+ * @{
+ */
+
+/** @brief Maximum number of pixel columns a chart decimates to */
+#define MU_CHART_MAX_COLUMNS 1024
+
+/** @brief Chart option flags (combined with MU_OPT_* flags) */
+enum
+{
+  MU_CHART_LTTB = (1 << 16),     /**< Largest-triangle-three-buckets instead of min/max */
+  MU_CHART_AUTOSCALE = (1 << 17) /**< Fit the vertical range to the visible samples */
+};
+
+/** @brief Ring buffer of samples - storage is provided by the app */
+typedef struct
+{
+  float *samples;   /**< Sample storage */
+  int capacity;     /**< Number of slots in `samples` */
+  int start;        /**< Index of the oldest sample */
+  int count;        /**< Number of valid samples */
+  unsigned version; /**< Incremented whenever samples change */
+} mu_Series;
+
+/** @brief Retained chart state - view and decimation cache */
+typedef struct
+{
+  int offset;     /**< Samples between the newest sample and the right edge (0 = follow) */
+  int span;       /**< Number of visible samples (0 = whole series) */
+  float low;      /**< Bottom of the vertical range */
+  float high;     /**< Top of the vertical range */
+
+  /* decimation cache */
+  unsigned cached_version;          /**< Series version the cache was built from */
+  int cached_width;                 /**< Column count the cache was built for */
+  int cached_first;                 /**< First visible sample of the cached view */
+  int cached_count;                 /**< Sample count of the cached view */
+  int cached_opt;                   /**< Decimation options of the cached view */
+  float mins[MU_CHART_MAX_COLUMNS]; /**< Per-column minimum */
+  float maxs[MU_CHART_MAX_COLUMNS]; /**< Per-column maximum */
+} mu_Chart;
+
+/** @brief Attach a ring buffer to app-owned storage
+ * @param series Series to initialize
+ * @param storage Sample storage
+ * @param capacity Number of samples `storage` can hold
+ */
+void mu_series_init(mu_Series *series, float *storage, int capacity);
+
+/** @brief Append samples, overwriting the oldest once the buffer is full
+ * @param series Series to append to
+ * @param values Samples to append
+ * @param count Number of samples
+ */
+void mu_series_push(mu_Series *series, const float *values, int count);
+
+/** @brief Get a sample by logical index (0 = oldest)
+ * @param series Series to read
+ * @param idx Logical index
+ * @return Sample value
+ */
+float mu_series_get(const mu_Series *series, int idx);
+
+/** @brief Initialize chart state with a fixed vertical range
+ * @param chart Chart to initialize
+ * @param low Bottom of the vertical range
+ * @param high Top of the vertical range
+ */
+void mu_chart_init(mu_Chart *chart, float low, float high);
+
+/** @brief Draw a chart in the next layout cell
+ *
+ * Dragging the chart with the left mouse button pans the view.
+ *
+ * @param context UI context
+ * @param chart Retained chart state
+ * @param series Samples to plot
+ * @param color Plot color
+ * @param opt Options (MU_OPT_*, MU_CHART_*)
+ * @return Result flags (MU_RES_*)
+ */
+int mu_chart_ex(mu_Context *context, mu_Chart *chart, const mu_Series *series, mu_Color color, int opt);
+
+/** @brief Macro: Create a standard chart using the text color */
+#define mu_chart(context, chart, series) mu_chart_ex(context, chart, series, (context)->style->colors[MU_COLOR_TEXT], 0)
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,84 @@
+/**
+ * @file microui_combobox.h
+ * @brief Searchable combobox over large item sets
+ *
+ * A combobox is a text field with a dropdown list of the items whose text
+ * starts with what has been typed, ignoring ASCII case. The items are
+ * sorted once into an index, so the matches for any prefix form one range
+ * of it, found with two binary searches; when the query grows the search
+ * stays inside the previous range. The dropdown reserves the height of
+ * every match but only builds the rows inside its clip rectangle, so
+ * neither typing nor drawing depends on the number of items.
+ */
+
+#ifndef MICROUI_COMBOBOX_H
+#define MICROUI_COMBOBOX_H
+
+#include "microui.h"
+#include "microui_textfield.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @defgroup ComboBox Combobox
+ * @brief Picking one item from a large set by typing a prefix
+ * @{
+ */
+
+/** @brief Size of the query buffer including the terminator */
+#define MU_COMBOBOX_QUERY_SIZE 128
+/** @brief Rows visible in the dropdown before it scrolls */
+#define MU_COMBOBOX_ROWS 8
+
+/** @brief Retained combobox state */
+typedef struct
+{
+  const char **items; /**< Item texts (not owned) */
+  int *order;         /**< Item indices sorted by text, ignoring ASCII case */
+  int count;          /**< Number of items */
+
+  mu_TextField field;                    /**< Query field */
+  char text[MU_COMBOBOX_QUERY_SIZE];     /**< Query text */
+  int widths[MU_COMBOBOX_QUERY_SIZE];    /**< Query prefix widths */
+  char filtered[MU_COMBOBOX_QUERY_SIZE]; /**< Query the range below was found for */
+
+  int first, last; /**< Range of `order` matching the query */
+  int highlight;   /**< Highlighted match, relative to `first` */
+  int jump;        /**< Non-zero to scroll `highlight` into view */
+  int selected;    /**< Chosen item index (-1 for none) */
+  int open;        /**< Non-zero once the dropdown has been opened */
+} mu_ComboBox;
+
+/** @brief Initialize a combobox and sort its index
+ * @param combo Combobox to initialize
+ * @param items Item texts, which must outlive the combobox
+ * @param order Storage for `count` indices
+ * @param count Number of items
+ */
+void mu_combobox_init(mu_ComboBox *combo, const char **items, int *order, int count);
+
+/** @brief Draw a combobox in the next layout cell
+ *
+ * Typing opens the dropdown; up and down move the highlight, return or a
+ * click chooses an item and puts its text in the field.
+ *
+ * @param context UI context
+ * @param name Name of the dropdown container, unique per combobox
+ * @param combo Combobox to draw
+ * @param opt Options (MU_OPT_*)
+ * @return MU_RES_CHANGE when an item is chosen
+ */
+int mu_combobox_ex(mu_Context *context, const char *name, mu_ComboBox *combo, int opt);
+
+/** @brief Macro: Draw a combobox with default options */
+#define mu_combobox(context, name, combo) mu_combobox_ex(context, name, combo, 0)
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
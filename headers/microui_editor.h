@@ -0,0 +1,167 @@
+/**
+ * @file microui_editor.h
+ * @brief Multi-line text editor over a gap buffer
+ *
+ * Text lives in an app-provided gap buffer, so typing at the caret only
+ * moves the bytes between the old and new caret positions. A sorted index
+ * of line start offsets maps rows to text and is patched in place by each
+ * edit. The editor reserves the height of every line in the current
+ * container but only measures and draws the lines inside the clip
+ * rectangle; caret placement uses a cached table of prefix widths for one
+ * line at a time.
+ *
+ * An optional tokenizer colors the text. The tokenizer state at the start
+ * of each line is kept, so an edit re-tokenizes from the changed line only
+ * until the state matches what the next line already had, and only as far
+ * down as the lines being drawn. A line the gap splits is handed to the
+ * tokenizer as a copy, so drawing never moves the gap; only lines longer
+ * than MU_EDITOR_LINE_SIZE move it out of the way instead.
+ */
+
+#ifndef MICROUI_EDITOR_H
+#define MICROUI_EDITOR_H
+
+#include "microui.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @defgroup Editor Text Editor
+ * @brief Multi-line editing of large documents
+ * @{
+ */
+
+/** @brief Bytes of a line covered by the prefix width cache */
+#define MU_EDITOR_CACHE_SIZE 1024
+
+/** @brief Longest line the tokenizer reads from a copy when the gap splits it */
+#define MU_EDITOR_LINE_SIZE 1024
+
+/** @brief Most colored runs a tokenizer can return for one line */
+#define MU_EDITOR_MAX_RUNS 64
+
+/** @brief A colored span of a line */
+typedef struct
+{
+  int offset;     /**< Byte offset in the line */
+  int length;     /**< Length in bytes */
+  mu_Color color; /**< Text color */
+} mu_TextRun;
+
+/** @brief Split one line into colored runs
+ *
+ * Runs must be in order and must not overlap; text outside every run is
+ * drawn in the style's text color.
+ *
+ * @param user User data given to mu_editor_set_tokenizer
+ * @param state Tokenizer state at the start of the line
+ * @param text Line text, without the newline
+ * @param length Length of `text` in bytes
+ * @param runs Output runs
+ * @param run_count Receives the number of runs written (at most MU_EDITOR_MAX_RUNS)
+ * @return Tokenizer state at the end of the line
+ */
+typedef int (*mu_Tokenizer)(void *user, int state, const char *text, int length, mu_TextRun *runs, int *run_count);
+
+/** @brief Retained editor state */
+typedef struct
+{
+  char *buffer;  /**< Gap buffer storage */
+  int capacity;  /**< Bytes in `buffer`, including room for a terminator */
+  int gap_start; /**< Start of the gap */
+  int gap_end;   /**< End of the gap */
+
+  int *lines;        /**< Text offset of each line start, ascending */
+  int line_capacity; /**< Slots in `lines` */
+  int line_count;    /**< Number of lines (at least 1) */
+
+  int caret;       /**< Caret text offset */
+  int anchor;      /**< Other end of the selection (== caret for none) */
+  int preferred_x; /**< Caret x kept across vertical moves (-1 for none) */
+  int reveal;      /**< Non-zero to scroll the caret into view */
+  int max_width;   /**< Widest line measured so far */
+  unsigned version; /**< Incremented by every edit */
+
+  int cache_line;      /**< Line the prefix widths belong to (-1 for none) */
+  unsigned cache_version; /**< `version` the cache was built at */
+  int cache_count;     /**< Bytes covered by `cache` */
+  int cache[MU_EDITOR_CACHE_SIZE + 1]; /**< Width of the first n bytes */
+
+  mu_Tokenizer tokenize; /**< Tokenizer, or NULL for plain text */
+  void *tokenize_user;   /**< User data for `tokenize` */
+  int *states;           /**< Tokenizer state at each line start, `line_capacity` slots */
+  int dirty_first;       /**< First line whose start state may be stale (-1 for none) */
+  int dirty_last;        /**< Last line changed since states were valid */
+  char line[MU_EDITOR_LINE_SIZE]; /**< Copy of a line split by the gap, for the tokenizer */
+} mu_Editor;
+
+/** @brief Initialize an empty editor over app storage
+ * @param editor Editor to initialize
+ * @param buffer Storage for text
+ * @param capacity Bytes in `buffer`
+ * @param lines Storage for the line index
+ * @param line_capacity Slots in `lines`
+ */
+void mu_editor_init(mu_Editor *editor, char *buffer, int capacity, int *lines, int line_capacity);
+
+/** @brief Replace the whole text
+ * @param editor Editor to modify
+ * @param text New text
+ * @param length Length of `text` in bytes (-1 for null-terminated)
+ * @return 1 on success, 0 if the text or its lines do not fit
+ */
+int mu_editor_set_text(mu_Editor *editor, const char *text, int length);
+
+/** @brief Get the text as one null-terminated string
+ *
+ * Moves the gap to the end of the buffer; the pointer stays valid until
+ * the next edit.
+ *
+ * @param editor Editor to query
+ * @return Pointer to the text
+ */
+const char *mu_editor_text(mu_Editor *editor);
+
+/** @brief Get the text length in bytes */
+int mu_editor_length(mu_Editor *editor);
+
+/** @brief Replace the selection with text, as if it was typed
+ * @param editor Editor to modify
+ * @param text Text to insert
+ * @param length Length of `text` in bytes (-1 for null-terminated)
+ * @return 1 on success, 0 if it does not fit
+ */
+int mu_editor_insert(mu_Editor *editor, const char *text, int length);
+
+/** @brief Color the text with a tokenizer
+ * @param editor Editor to modify
+ * @param tokenize Tokenizer, or NULL to draw plain text
+ * @param user User data passed to `tokenize`
+ * @param states Storage for one state per line, with as many slots as the line index
+ */
+void mu_editor_set_tokenizer(mu_Editor *editor, mu_Tokenizer tokenize, void *user, int *states);
+
+/** @brief Draw an editor in the current container and handle its input
+ *
+ * The editor takes the full width of the layout row and the height of all
+ * of its lines, so it is normally the only content of a panel.
+ *
+ * @param context UI context
+ * @param editor Editor to draw
+ * @param opt Options (MU_OPT_*)
+ * @return Result flags (MU_RES_ACTIVE while focused, MU_RES_CHANGE on edit)
+ */
+int mu_editor_ex(mu_Context *context, mu_Editor *editor, int opt);
+
+/** @brief Macro: Draw an editor with default options */
+#define mu_editor(context, editor) mu_editor_ex(context, editor, 0)
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,102 @@
+/**
+ * @file microui_histogram.h
+ * @brief Streaming histogram widget with incremental binning
+ *
+ * Samples are binned as they arrive and then dropped, so neither the app
+ * nor the UI keeps them: the mu_Histogram state only holds one count per
+ * bin. Bins are linear or logarithmic. Changing the range re-bins the
+ * existing counts by spreading each old bin over the new bins it overlaps,
+ * which costs one pass over the bins rather than over the samples. The
+ * widget draws one rectangle per non-empty bin.
+ */
+
+#ifndef MICROUI_HISTOGRAM_H
+#define MICROUI_HISTOGRAM_H
+
+#include "microui.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @defgroup Histogram Histogram Widget
+ * @brief Distributions of sample streams
+ * @{
+ */
+
+/** @brief Maximum number of bins */
+#define MU_HISTOGRAM_MAX_BINS 256
+
+/** @brief Histogram option flags (given to mu_histogram_init) */
+enum
+{
+  MU_HISTOGRAM_LOG = (1 << 16),      /**< Bins of equal width in log2(value) */
+  MU_HISTOGRAM_AUTORANGE = (1 << 17) /**< Widen the range to fit new samples */
+};
+
+/** @brief Retained histogram state */
+typedef struct
+{
+  float low;  /**< Lower edge of the first bin */
+  float high; /**< Upper edge of the last bin */
+  int bins;   /**< Number of bins */
+  int opt;    /**< MU_HISTOGRAM_* flags */
+
+  double counts[MU_HISTOGRAM_MAX_BINS]; /**< Samples per bin (fractional after re-binning) */
+  double underflow;  /**< Samples below `low`, NaN, or not positive on a log scale */
+  double overflow;   /**< Samples at or above `high` */
+  double total;      /**< All samples pushed */
+  unsigned version;  /**< Incremented whenever counts change */
+} mu_Histogram;
+
+/** @brief Initialize an empty histogram
+ * @param histogram Histogram to initialize
+ * @param low Lower edge of the first bin (positive for MU_HISTOGRAM_LOG)
+ * @param high Upper edge of the last bin
+ * @param bins Number of bins, at most MU_HISTOGRAM_MAX_BINS
+ * @param opt MU_HISTOGRAM_* flags
+ */
+void mu_histogram_init(mu_Histogram *histogram, float low, float high, int bins, int opt);
+
+/** @brief Reset every count to zero, keeping the range */
+void mu_histogram_clear(mu_Histogram *histogram);
+
+/** @brief Change the range, re-binning the existing counts
+ *
+ * Counts in bins that fall outside the new range move to the underflow
+ * or overflow counts; the underflow and overflow counts themselves stay
+ * where they are since their values are unknown.
+ *
+ * @param histogram Histogram to modify
+ * @param low New lower edge
+ * @param high New upper edge
+ */
+void mu_histogram_set_range(mu_Histogram *histogram, float low, float high);
+
+/** @brief Bin a batch of samples
+ * @param histogram Histogram to update
+ * @param values Samples
+ * @param count Number of samples
+ */
+void mu_histogram_push(mu_Histogram *histogram, const float *values, int count);
+
+/** @brief Draw a histogram in the next layout cell
+ * @param context UI context
+ * @param histogram Histogram to draw
+ * @param color Bar color
+ * @param opt Options (MU_OPT_*)
+ */
+void mu_histogram_ex(mu_Context *context, const mu_Histogram *histogram, mu_Color color, int opt);
+
+/** @brief Macro: Draw a histogram using the text color */
+#define mu_histogram(context, histogram) \
+  mu_histogram_ex(context, histogram, (context)->style->colors[MU_COLOR_TEXT], 0)
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
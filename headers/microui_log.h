@@ -0,0 +1,156 @@
+/**
+ * @file microui_log.h
+ * @brief Append-only log view over a ring buffer of lines
+ *
+ * Text is stored in an app-provided byte ring and indexed by a second ring
+ * of line offsets. Appending a line copies it once and evicts the oldest
+ * lines it overwrites, so appends cost O(length) regardless of how much is
+ * already buffered. The widget reserves the height of every line but only
+ * draws the lines inside the clip rectangle, and keeps following the newest
+ * line while the view is scrolled to the bottom.
+ *
+ * A log can carry a search that indexes matching lines incrementally. Each
+ * draw scans a bounded number of bytes, so searching a very large log is
+ * spread over several frames instead of stalling one.
+ */
+
+#ifndef MICROUI_LOG_H
+#define MICROUI_LOG_H
+
+#include "microui.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @defgroup Log Log View
+ * @brief High-rate log output with bounded memory
+ * @{
+ */
+
+/** @brief Maximum search pattern length including the terminator */
+#define MU_LOG_PATTERN_SIZE 64
+/** @brief Bytes of text a search scans per draw */
+#define MU_LOG_SEARCH_BUDGET (4 << 20)
+
+/** @brief Location of one line in the text ring */
+typedef struct
+{
+  int offset; /**< Byte offset in the text ring */
+  int length; /**< Length in bytes, without a terminator */
+} mu_LogLine;
+
+/** @brief Incremental search over a log
+ *
+ * Lines are identified by their absolute number, counting every line
+ * appended since the log was initialized, so matches stay valid while the
+ * ring evicts old lines.
+ */
+typedef struct
+{
+  char pattern[MU_LOG_PATTERN_SIZE]; /**< Text searched for (empty = off) */
+  int length;                        /**< Length of `pattern` */
+
+  unsigned long long *matches; /**< Ring of matching line numbers, ascending */
+  int match_capacity;          /**< Slots in `matches` */
+  int match_first;             /**< Slot of the oldest match */
+  int match_count;             /**< Number of indexed matches */
+
+  unsigned long long scanned; /**< Number of the next line to scan */
+  long long current;          /**< Line of the selected hit (-1 for none) */
+  int jump;                   /**< Non-zero to scroll `current` into view */
+} mu_LogSearch;
+
+/** @brief Retained log state */
+typedef struct
+{
+  char *text;        /**< Text ring; lines are stored contiguously */
+  int text_capacity; /**< Bytes in `text` */
+  int write;         /**< Offset the next line is written at */
+
+  mu_LogLine *lines; /**< Line index ring */
+  int line_capacity; /**< Slots in `lines` */
+  int first;         /**< Slot of the oldest line */
+  int count;         /**< Number of buffered lines */
+
+  unsigned long long total; /**< Lines appended since init */
+  unsigned long long shown; /**< Value of `total` at the last draw */
+
+  mu_LogSearch *search; /**< Active search (NULL for none) */
+} mu_Log;
+
+/** @brief Initialize a log over app storage
+ * @param log Log to initialize
+ * @param text Storage for line text
+ * @param text_capacity Bytes in `text`
+ * @param lines Storage for the line index
+ * @param line_capacity Slots in `lines`
+ */
+void mu_log_init(mu_Log *log, char *text, int text_capacity, mu_LogLine *lines, int line_capacity);
+
+/** @brief Remove all lines */
+void mu_log_clear(mu_Log *log);
+
+/** @brief Append text, starting a new line at every '\n'
+ * @param log Log to append to
+ * @param text Text to append
+ * @param length Length of `text` in bytes (-1 for null-terminated)
+ */
+void mu_log_append(mu_Log *log, const char *text, int length);
+
+/** @brief Get a buffered line
+ * @param log Log to query
+ * @param idx Line index, 0 being the oldest buffered line
+ * @param length Receives the line length
+ * @return Pointer to the line text (not null-terminated)
+ */
+const char *mu_log_line(mu_Log *log, int idx, int *length);
+
+/** @brief Initialize a search over app storage and attach it to a log
+ * @param log Log to search
+ * @param search Search to initialize
+ * @param matches Storage for the match index
+ * @param match_capacity Slots in `matches`; the oldest matches are dropped when full
+ */
+void mu_log_search_init(mu_Log *log, mu_LogSearch *search, unsigned long long *matches, int match_capacity);
+
+/** @brief Start searching for a new pattern, discarding the old matches
+ * @param search Search to modify
+ * @param pattern Text to find (empty to stop searching)
+ */
+void mu_log_search_set(mu_LogSearch *search, const char *pattern);
+
+/** @brief Index matches in lines not scanned yet
+ * @param log Log to scan
+ * @param budget Maximum number of bytes to scan
+ * @return 1 if every buffered line has been scanned, 0 if more remain
+ */
+int mu_log_search_step(mu_Log *log, int budget);
+
+/** @brief Select the next or previous hit and scroll it into view
+ * @param log Log being searched
+ * @param direction 1 for the next hit, -1 for the previous one
+ * @return 1 if a hit was selected, 0 if there is none in that direction
+ */
+int mu_log_search_next(mu_Log *log, int direction);
+
+/** @brief Draw the visible lines of a log in the current container
+ *
+ * When new lines arrived since the last draw and the container was scrolled
+ * to the bottom, it is scrolled to the bottom again. With a search attached,
+ * the search is advanced by MU_LOG_SEARCH_BUDGET bytes and matches on the
+ * visible lines are highlighted.
+ *
+ * @param context UI context
+ * @param log Log to draw
+ */
+void mu_log(mu_Context *context, mu_Log *log);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
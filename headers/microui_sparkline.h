@@ -0,0 +1,85 @@
+/**
+ * @file microui_sparkline.h
+ * @brief Batched sparklines for dense metric tables
+ *
+ * A sparkline is a small line graph without axes, one per table cell. Each
+ * is laid out through mu_layout_next like any other widget and decimated
+ * to a fixed number of points, but instead of emitting a lines command per
+ * cell the points are appended to a shared batch which goes out as a single
+ * polylines command when the batch ends or fills up. Cells outside the
+ * clip rectangle are skipped before their values are read, so a large table
+ * only pays for the rows on screen.
+ */
+
+#ifndef MICROUI_SPARKLINE_H
+#define MICROUI_SPARKLINE_H
+
+#include "microui.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @defgroup Sparkline Sparklines
+ * @brief Batched inline line graphs
+ * @{
+ */
+
+/** @brief Batch of sparklines sharing one command */
+typedef struct
+{
+  mu_Vector2 *points; /**< Point storage */
+  int capacity;       /**< Slots in `points` */
+  int count;          /**< Points waiting to be drawn */
+  int columns;        /**< Points per sparkline */
+  mu_Color color;     /**< Line color */
+} mu_Sparklines;
+
+/** @brief Start a batch over app storage
+ *
+ * Every sparkline in the batch is drawn with the same color and the same
+ * clip rectangle, so a batch should not span containers or clip pushes.
+ *
+ * @param context UI context
+ * @param batch Batch to start
+ * @param points Storage for points, a few rows' worth or more
+ * @param capacity Slots in `points`
+ * @param columns Points per sparkline, typically around the cell width
+ * @param color Line color
+ */
+void mu_sparklines_begin(mu_Context *context, mu_Sparklines *batch, mu_Vector2 *points, int capacity,
+                         int columns, mu_Color color);
+
+/** @brief Add a sparkline in the next layout cell
+ *
+ * Values are split into `columns` equal buckets, each drawn as the bucket's
+ * minimum or maximum, whichever is further from the previous point, so
+ * spikes survive decimation.
+ *
+ * @param context UI context
+ * @param batch Batch to add to
+ * @param values Samples, oldest first
+ * @param count Number of samples
+ * @param low Value at the bottom of the cell
+ * @param high Value at the top of the cell; if not above `low`, the cell
+ *        is scaled to the range of its values
+ * @param opt Options (MU_OPT_*)
+ */
+void mu_sparkline_ex(mu_Context *context, mu_Sparklines *batch, const float *values, int count, float low,
+                     float high, int opt);
+
+/** @brief Macro: Add a sparkline scaled to its values, without a frame */
+#define mu_sparkline(context, batch, values, count) \
+  mu_sparkline_ex(context, batch, values, count, 0, 0, MU_OPT_NOFRAME)
+
+/** @brief Draw the pending sparklines and end the batch */
+void mu_sparklines_end(mu_Context *context, mu_Sparklines *batch);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
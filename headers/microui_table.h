@@ -0,0 +1,118 @@
+/**
+ * @file microui_table.h
+ * @brief Virtualized table over a column-oriented data source
+ *
+ * The table reserves the full size of its rows in the layout, so the
+ * enclosing panel's scrollbars work as usual, but only the cells that
+ * intersect the clip rectangle are fetched and drawn. Cells are fetched
+ * column by column over the visible rows, which streams struct-of-arrays
+ * data through the cache.
+ *
+ * Sorting permutes an app-provided index array; the data itself never moves.
+ * Auto-sized column widths are measured from the visible cells and cached,
+ * and only re-measured when the visible row range changes.
+ */
+
+#ifndef MICROUI_TABLE_H
+#define MICROUI_TABLE_H
+
+#include "microui.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @defgroup Table Table Widget
+ * @brief Constant-cost tables over millions of rows
+ * @{
+ */
+
+/** @brief Maximum number of columns in a table */
+#define MU_TABLE_MAX_COLUMNS 32
+/** @brief Size of the scratch buffer passed to the cell callback */
+#define MU_TABLE_CELL_SIZE 128
+
+/** @brief Data callbacks supplied by the app */
+typedef struct
+{
+  /** @brief Text of a cell; may format into `buffer` and return it */
+  const char *(*cell)(void *user, int column, int row, char *buffer, int size);
+  /** @brief Order of two rows by a column (<0, 0, >0); NULL disables sorting */
+  int (*compare)(void *user, int column, int a, int b);
+  void *user; /**< Passed to every callback */
+} mu_TableSource;
+
+/** @brief Column description and cached measurement */
+typedef struct
+{
+  const char *title; /**< Header text */
+  int width;         /**< Fixed width in pixels (0 = measure) */
+  int measured;      /**< Cached measured width */
+} mu_TableColumn;
+
+/** @brief Retained table state */
+typedef struct
+{
+  mu_TableSource source;                        /**< Data callbacks */
+  mu_TableColumn columns[MU_TABLE_MAX_COLUMNS]; /**< Column descriptions */
+  int column_count;                             /**< Number of columns */
+  int row_count;                                /**< Number of data rows */
+  int *order;         /**< Display-to-data row permutation (NULL = identity) */
+  int sort_column;    /**< Column the order is sorted by (-1 for none) */
+  int sort_descending; /**< Non-zero for descending order */
+  int selected;       /**< Selected data row (-1 for none) */
+  int measured_first; /**< First row of the last measured range */
+  int measured_last;  /**< End of the last measured range */
+} mu_Table;
+
+/** @brief Initialize a table
+ * @param table Table to initialize
+ * @param source Data callbacks
+ * @param row_count Number of data rows
+ * @param order Permutation storage with room for `row_count` entries (NULL if unsorted)
+ */
+void mu_table_init(mu_Table *table, mu_TableSource source, int row_count, int *order);
+
+/** @brief Append a column
+ * @param table Table to modify
+ * @param title Header text
+ * @param width Fixed width in pixels, or 0 to size from the content
+ */
+void mu_table_add_column(mu_Table *table, const char *title, int width);
+
+/** @brief Change the number of rows, resetting and re-sorting the permutation
+ * @param table Table to modify
+ * @param row_count New number of data rows
+ */
+void mu_table_set_rows(mu_Table *table, int row_count);
+
+/** @brief Sort the permutation by a column
+ * @param table Table to sort
+ * @param column Column index
+ * @param descending Non-zero for descending order
+ */
+void mu_table_sort(mu_Table *table, int column, int descending);
+
+/** @brief Draw the visible part of a table in the current container
+ *
+ * The header row sticks to the top of the clip rectangle. Clicking a header
+ * sorts by that column (again to reverse); clicking a row selects it.
+ *
+ * @param context UI context
+ * @param table Table to draw
+ * @param opt Options (MU_OPT_*)
+ * @return MU_RES_CHANGE if the selection or sort order changed
+ */
+int mu_table_ex(mu_Context *context, mu_Table *table, int opt);
+
+/** @brief Macro: Draw a table with default options */
+#define mu_table(context, table) mu_table_ex(context, table, 0)
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,82 @@
+/**
+ * @file microui_textfield.h
+ * @brief Single-line text field with a caret, selection and horizontal scroll
+ *
+ * Unlike mu_textbox, which re-measures its whole buffer every frame, a
+ * text field keeps a table of prefix widths in app storage. Edits patch the
+ * table in place, clicks map to a byte offset by binary search over it, and
+ * drawing emits only the slice of text inside the field, so cost does not
+ * grow with the length of the text.
+ */
+
+#ifndef MICROUI_TEXTFIELD_H
+#define MICROUI_TEXTFIELD_H
+
+#include "microui.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @defgroup TextField Text Field
+ * @brief Single-line editing of long text
+ * @{
+ */
+
+/** @brief Retained text field state */
+typedef struct
+{
+  char *buffer; /**< Null-terminated text */
+  int size;     /**< Bytes in `buffer` */
+  int length;   /**< Text length in bytes */
+  int *widths;  /**< Width of the first n bytes, `size` entries */
+  int measured; /**< Entries of `widths` that are valid */
+  mu_Font font; /**< Font `widths` was measured with */
+
+  int caret;  /**< Caret byte offset */
+  int anchor; /**< Other end of the selection (== caret for none) */
+  int scroll; /**< Horizontal scroll in pixels */
+} mu_TextField;
+
+/** @brief Initialize an empty text field over app storage
+ * @param field Field to initialize
+ * @param buffer Storage for text
+ * @param size Bytes in `buffer`
+ * @param widths Storage for `size` prefix widths
+ */
+void mu_textfield_init(mu_TextField *field, char *buffer, int size, int *widths);
+
+/** @brief Replace the whole text, placing the caret at the end
+ * @param field Field to modify
+ * @param text New text (truncated to fit)
+ * @param length Length of `text` in bytes (-1 for null-terminated)
+ */
+void mu_textfield_set_text(mu_TextField *field, const char *text, int length);
+
+/** @brief Replace the selection with text, as if it was typed
+ * @param field Field to modify
+ * @param text Text to insert
+ * @param length Length of `text` in bytes (-1 for null-terminated)
+ * @return 1 on success, 0 if it does not fit
+ */
+int mu_textfield_insert(mu_TextField *field, const char *text, int length);
+
+/** @brief Draw a text field in the next layout cell and handle its input
+ * @param context UI context
+ * @param field Field to draw
+ * @param opt Options (MU_OPT_*)
+ * @return Result flags (MU_RES_CHANGE on edit, MU_RES_SUBMIT on return)
+ */
+int mu_textfield_ex(mu_Context *context, mu_TextField *field, int opt);
+
+/** @brief Macro: Draw a text field with default options */
+#define mu_textfield(context, field) mu_textfield_ex(context, field, 0)
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
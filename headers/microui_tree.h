@@ -0,0 +1,122 @@
+/**
+ * @file microui_tree.h
+ * @brief Virtualized tree view over an app-provided hierarchy
+ *
+ * Unlike mu_begin_treenode(), which keeps one pool slot per open node and
+ * lays out every visible node each frame, the tree view keeps its expansion
+ * state in an open-addressed hash set and flattens the expanded part of the
+ * hierarchy into an array of visible rows. Expanding or collapsing a node
+ * splices that node's subtree into or out of the row array, and each frame
+ * only the rows intersecting the clip rectangle are laid out and drawn.
+ *
+ * All storage is provided by the app.
+ */
+
+#ifndef MICROUI_TREE_H
+#define MICROUI_TREE_H
+
+#include "microui.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @defgroup Tree Tree View
+ * @brief Virtualized tree over millions of nodes
+ * @{
+ */
+
+/** @brief App node key - 0 is reserved */
+typedef unsigned long long mu_TreeKey;
+
+/** @brief Hierarchy callbacks supplied by the app */
+typedef struct
+{
+  /** @brief Number of children of `node` */
+  int (*child_count)(void *user, mu_TreeKey node);
+  /** @brief Key of the `idx`th child of `node` */
+  mu_TreeKey (*child)(void *user, mu_TreeKey node, int idx);
+  /** @brief Label of `node`; must stay valid until the frame's commands are built */
+  const char *(*label)(void *user, mu_TreeKey node);
+  void *user; /**< Passed to every callback */
+} mu_TreeSource;
+
+/** @brief One visible row of the flattened tree */
+typedef struct
+{
+  mu_TreeKey key;
+  int depth;
+} mu_TreeRow;
+
+/** @brief Retained tree state */
+typedef struct
+{
+  mu_TreeSource source; /**< Hierarchy callbacks */
+  mu_TreeKey root;      /**< Node whose children form the top level */
+  mu_TreeKey selected;  /**< Selected node (0 for none) */
+
+  mu_TreeKey *expanded;  /**< Hash set of expanded keys */
+  int expanded_capacity; /**< Slots in `expanded` (power of two) */
+  int expanded_count;    /**< Keys in `expanded` */
+
+  mu_TreeRow *rows;  /**< Flattened visible rows */
+  int row_capacity;  /**< Slots in `rows` */
+  int row_count;     /**< Number of visible rows */
+} mu_Tree;
+
+/** @brief Initialize a tree over app storage and build the top-level rows
+ * @param tree Tree to initialize
+ * @param source Hierarchy callbacks
+ * @param root Node whose children are shown at depth 0
+ * @param expanded Storage for the expansion set
+ * @param expanded_capacity Slots in `expanded` (power of two)
+ * @param rows Storage for visible rows
+ * @param row_capacity Slots in `rows`
+ */
+void mu_tree_init(mu_Tree *tree, mu_TreeSource source, mu_TreeKey root,
+                  mu_TreeKey *expanded, int expanded_capacity,
+                  mu_TreeRow *rows, int row_capacity);
+
+/** @brief Rebuild all rows from the expansion set after the hierarchy changed
+ * @param tree Tree to rebuild
+ */
+void mu_tree_rebuild(mu_Tree *tree);
+
+/** @brief Check whether a node is expanded
+ * @param tree Tree to query
+ * @param key Node key
+ * @return 1 if expanded, 0 otherwise
+ */
+int mu_tree_is_expanded(mu_Tree *tree, mu_TreeKey key);
+
+/** @brief Expand or collapse the node shown at a row
+ * @param tree Tree to modify
+ * @param row Visible row index
+ * @return 1 if the tree changed, 0 if not (already in that state or out of storage)
+ */
+int mu_tree_toggle(mu_Tree *tree, int row);
+
+/** @brief Draw the visible rows of a tree in the current container
+ *
+ * The tree reserves its full height in the layout so the container's
+ * scrollbars cover it, but only rows inside the clip rectangle are drawn.
+ * Clicking the arrow toggles a node, clicking the label selects it.
+ *
+ * @param context UI context
+ * @param tree Tree to draw
+ * @param opt Options (MU_OPT_*)
+ * @return MU_RES_CHANGE if the selection or expansion changed
+ */
+int mu_tree_ex(mu_Context *context, mu_Tree *tree, int opt);
+
+/** @brief Macro: Draw a tree with default options */
+#define mu_tree(context, tree) mu_tree_ex(context, tree, 0)
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -37,6 +37,7 @@
  * each frame, and drawing commands are collected for rendering.
  */
 
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -221,6 +222,9 @@ void mu_begin(mu_Context *context)
   context->next_hover_root = NULL;
   context->mouse_delta.x = context->mouse_pos.x - context->last_mouse_pos.x;
   context->mouse_delta.y = context->mouse_pos.y - context->last_mouse_pos.y;
+  context->animation_rect = mu_rect(0, 0, 0, 0);
+  context->animation_pending = 0;
+  context->begin_focus = context->focus;
   context->frame++;
 }
 
@@ -260,6 +264,16 @@ void mu_end(mu_Context *context)
     mu_bring_to_front(context, context->next_hover_root);
   }
 
+  /* scroll is applied above, drags move a container after its body is drawn
+  ** and the hover root takes effect next frame: show the result right away
+  ** instead of when the next unrelated event comes in */
+  if (context->input_received || context->next_hover_root != context->hover_root ||
+      context->focus != context->begin_focus)
+  {
+    mu_wake_at(context, context->time);
+  }
+  context->input_received = 0;
+
   /* reset input state */
   context->key_pressed = 0;
   context->input_text[0] = '\0';
@@ -352,7 +366,9 @@ mu_Rectangle mu_get_clip_rect(mu_Context *context)
 int mu_check_clip(mu_Context *context, mu_Rectangle renderer)
 {
   mu_Rectangle cr = mu_get_clip_rect(context);
-  if (renderer.x > cr.x + cr.w || renderer.x + renderer.w < cr.x ||
+  /* nothing shows through an empty clip rect, e.g. a widget scrolled out of view */
+  if (cr.w <= 0 || cr.h <= 0 ||
+      renderer.x > cr.x + cr.w || renderer.x + renderer.w < cr.x ||
       renderer.y > cr.y + cr.h || renderer.y + renderer.h < cr.y)
   {
     return MU_CLIP_ALL;
@@ -427,7 +443,12 @@ static mu_Container *get_container(mu_Context *context, mu_Identifier identifier
 
 mu_Container *mu_get_container(mu_Context *context, const char *name)
 {
-  mu_Identifier identifier = mu_get_id(context, name, strlen(name));
+  return mu_get_container_len(context, name, strlen(name));
+}
+
+mu_Container *mu_get_container_len(mu_Context *context, const char *name, int length)
+{
+  mu_Identifier identifier = mu_get_id(context, name, length);
   return get_container(context, identifier, 0);
 }
 
@@ -483,6 +504,7 @@ void mu_pool_update(mu_Context *context, mu_PoolItem *items, int idx)
 void mu_input_mousemove(mu_Context *context, int x, int y)
 {
   context->mouse_pos = mu_vec2(x, y);
+  context->input_received = 1;
 }
 
 void mu_input_mousedown(mu_Context *context, int x, int y, int btn)
@@ -502,17 +524,20 @@ void mu_input_scroll(mu_Context *context, int x, int y)
 {
   context->scroll_delta.x += x;
   context->scroll_delta.y += y;
+  context->input_received = 1;
 }
 
 void mu_input_keydown(mu_Context *context, int key)
 {
   context->key_pressed |= key;
   context->key_down |= key;
+  context->input_received = 1;
 }
 
 void mu_input_keyup(mu_Context *context, int key)
 {
   context->key_down &= ~key;
+  context->input_received = 1;
 }
 
 void mu_input_text(mu_Context *context, const char *text)
@@ -521,6 +546,99 @@ void mu_input_text(mu_Context *context, const char *text)
   int size = strlen(text) + 1;
   expect(length + size <= (int)sizeof(context->input_text));
   memcpy(context->input_text + length, text, size);
+  context->input_received = 1;
+}
+
+void mu_input_time(mu_Context *context, int milliseconds)
+{
+  context->time = milliseconds;
+}
+
+/*============================================================================
+** animation
+**============================================================================*/
+
+static mu_Real animation_value(mu_Animation *animation, int time)
+{
+  int elapsed = time - animation->start;
+  mu_Real t;
+  if (elapsed >= animation->duration)
+  {
+    return animation->to;
+  }
+  if (elapsed <= 0)
+  {
+    return animation->from;
+  }
+  /* smoothstep: eases in and out */
+  t = (mu_Real)elapsed / animation->duration;
+  return animation->from + (animation->to - animation->from) * t * t * (3 - 2 * t);
+}
+
+mu_Real mu_animate_ex(mu_Context *context, mu_Identifier identifier, mu_Rectangle rectangle, mu_Real target,
+                      int duration, int delay)
+{
+  mu_Animation *animation;
+  int idx = mu_pool_get(context, context->animation_pool, MU_ANIMATIONPOOL_SIZE, identifier);
+  if (idx < 0)
+  {
+    /* nothing to tween from yet */
+    idx = mu_pool_init(context, context->animation_pool, MU_ANIMATIONPOOL_SIZE, identifier);
+    animation = &context->animations[idx];
+    animation->from = animation->to = target;
+    animation->start = context->time;
+    animation->duration = 0;
+    return target;
+  }
+  mu_pool_update(context, context->animation_pool, idx);
+  animation = &context->animations[idx];
+  if (animation->to != target)
+  {
+    animation->from = animation_value(animation, context->time);
+    animation->to = target;
+    animation->start = context->time + mu_max(delay, 0);
+    animation->duration = mu_max(duration, 0);
+  }
+  if (context->time - animation->start >= animation->duration)
+  {
+    return animation->to;
+  }
+
+  /* a delayed tween sleeps until it starts, a running one needs every frame */
+  if (context->time - animation->start < 0)
+  {
+    mu_wake_at(context, animation->start);
+    return animation->from;
+  }
+  mu_wake_at(context, context->time);
+  if (context->animation_rect.w > 0 && context->animation_rect.h > 0)
+  {
+    mu_Rectangle r = context->animation_rect;
+    int x2 = mu_max(r.x + r.w, rectangle.x + rectangle.w), y2 = mu_max(r.y + r.h, rectangle.y + rectangle.h);
+    r.x = mu_min(r.x, rectangle.x);
+    r.y = mu_min(r.y, rectangle.y);
+    rectangle = mu_rect(r.x, r.y, x2 - r.x, y2 - r.y);
+  }
+  context->animation_rect = rectangle;
+  return animation_value(animation, context->time);
+}
+
+void mu_wake_at(mu_Context *context, int time)
+{
+  if (!context->animation_pending || time - context->animation_wake < 0)
+  {
+    context->animation_wake = time;
+  }
+  context->animation_pending = 1;
+}
+
+int mu_animation_timeout(mu_Context *context)
+{
+  if (!context->animation_pending)
+  {
+    return -1;
+  }
+  return mu_max(context->animation_wake - context->time, 0);
 }
 
 /*============================================================================
@@ -558,6 +676,28 @@ int mu_next_command(mu_Context *context, mu_Command **command)
   return 0;
 }
 
+int mu_next_container_command(mu_Container *container, mu_Command **command)
+{
+  if (*command)
+  {
+    *command = (mu_Command *)(((char *)*command) + (*command)->base.size);
+  }
+  else
+  {
+    *command = (mu_Command *)((char *)container->head + sizeof(mu_JumpCommand));
+  }
+  /* nested root containers are skipped by their head jump */
+  while (*command != container->tail)
+  {
+    if ((*command)->type != MU_COMMAND_JUMP)
+    {
+      return 1;
+    }
+    *command = (*command)->jump.dst;
+  }
+  return 0;
+}
+
 static mu_Command *push_jump(mu_Context *context, mu_Command *dst)
 {
   mu_Command *command;
@@ -651,6 +791,110 @@ void mu_draw_icon(mu_Context *context, int identifier, mu_Rectangle rectangle, m
   }
 }
 
+void mu_draw_lines(mu_Context *context, const mu_Vector2 *points, int count, mu_Color color)
+{
+  mu_draw_polylines(context, points, count, count, color);
+}
+
+void mu_draw_polylines(mu_Context *context, const mu_Vector2 *points, int count, int run, mu_Color color)
+{
+  mu_Command *command;
+  mu_Rectangle bounds;
+  int i, x2, y2, clipped;
+  count -= run > 0 ? count % run : count;
+  if (run < 2 || count < 2)
+  {
+    return;
+  }
+  /* clip the bounding box of all the polylines once */
+  bounds = mu_rect(points[0].x, points[0].y, 0, 0);
+  x2 = points[0].x;
+  y2 = points[0].y;
+  for (i = 1; i < count; i++)
+  {
+    bounds.x = mu_min(bounds.x, points[i].x);
+    bounds.y = mu_min(bounds.y, points[i].y);
+    x2 = mu_max(x2, points[i].x);
+    y2 = mu_max(y2, points[i].y);
+  }
+  bounds.w = x2 - bounds.x + 1;
+  bounds.h = y2 - bounds.y + 1;
+  clipped = mu_check_clip(context, bounds);
+  if (clipped == MU_CLIP_ALL)
+  {
+    return;
+  }
+  if (clipped == MU_CLIP_PART)
+  {
+    mu_set_clip(context, mu_get_clip_rect(context));
+  }
+  /* do lines command */
+  command = mu_push_command(context, MU_COMMAND_LINES,
+                            sizeof(mu_LinesCommand) + (count - 1) * sizeof(mu_Vector2));
+  memcpy(command->lines.points, points, count * sizeof(mu_Vector2));
+  command->lines.count = count;
+  command->lines.run = run;
+  command->lines.color = color;
+  /* reset clipping if it was set */
+  if (clipped)
+  {
+    mu_set_clip(context, unclipped_rect);
+  }
+}
+
+void mu_draw_image(mu_Context *context, mu_Texture texture, mu_Rectangle source,
+                   mu_Rectangle rectangle, mu_Color color)
+{
+  mu_Command *command;
+  /* do clip command if the rectangle isn't fully contained within the cliprect */
+  int clipped = mu_check_clip(context, rectangle);
+  if (clipped == MU_CLIP_ALL)
+  {
+    return;
+  }
+  if (clipped == MU_CLIP_PART)
+  {
+    mu_set_clip(context, mu_get_clip_rect(context));
+  }
+  /* do image command */
+  command = mu_push_command(context, MU_COMMAND_IMAGE, sizeof(mu_ImageCommand));
+  command->image.texture = texture;
+  command->image.source = source;
+  command->image.rectangle = rectangle;
+  command->image.color = color;
+  /* reset clipping if it was set */
+  if (clipped)
+  {
+    mu_set_clip(context, unclipped_rect);
+  }
+}
+
+void mu_draw_callback(mu_Context *context, mu_Rectangle rectangle,
+                      mu_DrawCallback callback, void *user_data)
+{
+  mu_Command *command;
+  /* do clip command if the rectangle isn't fully contained within the cliprect */
+  int clipped = mu_check_clip(context, rectangle);
+  if (clipped == MU_CLIP_ALL)
+  {
+    return;
+  }
+  if (clipped == MU_CLIP_PART)
+  {
+    mu_set_clip(context, mu_get_clip_rect(context));
+  }
+  /* do callback command */
+  command = mu_push_command(context, MU_COMMAND_CALLBACK, sizeof(mu_CallbackCommand));
+  command->callback.callback = callback;
+  command->callback.user_data = user_data;
+  command->callback.rectangle = rectangle;
+  /* reset clipping if it was set */
+  if (clipped)
+  {
+    mu_set_clip(context, unclipped_rect);
+  }
+}
+
 /*============================================================================
 ** layout
 **============================================================================*/
@@ -693,6 +937,18 @@ void mu_layout_row(mu_Context *context, int items, const int *widths, int height
   layout->item_index = 0;
 }
 
+mu_Rectangle mu_layout_rows_ex(mu_Context *context, int count, int row_height, int width, int padding, int *first,
+                               int *last)
+{
+  mu_Rectangle area, clip;
+  mu_layout_row(context, 1, &width, count * row_height + padding * 2);
+  area = mu_layout_next(context);
+  clip = mu_get_clip_rect(context);
+  *first = mu_max(0, (clip.y - area.y - padding) / row_height);
+  *last = mu_min(count, (clip.y + clip.h - area.y - padding + row_height - 1) / row_height);
+  return area;
+}
+
 void mu_layout_width(mu_Context *context, int width)
 {
   get_layout(context)->size.x = width;
@@ -814,10 +1070,16 @@ void mu_draw_control_frame(mu_Context *context, mu_Identifier identifier, mu_Rec
 
 void mu_draw_control_text(mu_Context *context, const char *str, mu_Rectangle rectangle,
                           int colorid, int opt)
+{
+  mu_draw_control_text_len(context, str, -1, rectangle, colorid, opt);
+}
+
+void mu_draw_control_text_len(mu_Context *context, const char *str, int length, mu_Rectangle rectangle,
+                              int colorid, int opt)
 {
   mu_Vector2 position;
   mu_Font font = context->style->font;
-  int tw = context->text_width(font, str, -1);
+  int tw = context->text_width(font, str, length);
   mu_push_clip_rect(context, rectangle);
   position.y = rectangle.y + (rectangle.h - context->text_height(font)) / 2;
   if (opt & MU_OPT_ALIGNCENTER)
@@ -832,7 +1094,7 @@ void mu_draw_control_text(mu_Context *context, const char *str, mu_Rectangle rec
   {
     position.x = rectangle.x + context->style->padding;
   }
-  mu_draw_text(context, font, str, -1, position, context->style->colors[colorid]);
+  mu_draw_text(context, font, str, length, position, context->style->colors[colorid]);
   mu_pop_clip_rect(context);
 }
 
@@ -924,10 +1186,20 @@ void mu_label(mu_Context *context, const char *text)
   mu_draw_control_text(context, text, mu_layout_next(context), MU_COLOR_TEXT, 0);
 }
 
+void mu_label_len(mu_Context *context, const char *text, int length)
+{
+  mu_draw_control_text_len(context, text, length, mu_layout_next(context), MU_COLOR_TEXT, 0);
+}
+
 int mu_button_ex(mu_Context *context, const char *label, int icon, int opt)
+{
+  return mu_button_len(context, label, label ? strlen(label) : 0, icon, opt);
+}
+
+int mu_button_len(mu_Context *context, const char *label, int length, int icon, int opt)
 {
   int res = 0;
-  mu_Identifier identifier = label ? mu_get_id(context, label, strlen(label))
+  mu_Identifier identifier = label ? mu_get_id(context, label, length)
                                    : mu_get_id(context, &icon, sizeof(icon));
   mu_Rectangle renderer = mu_layout_next(context);
   mu_update_control(context, identifier, renderer, opt);
@@ -940,7 +1212,7 @@ int mu_button_ex(mu_Context *context, const char *label, int icon, int opt)
   mu_draw_control_frame(context, identifier, renderer, MU_COLOR_BUTTON, opt);
   if (label)
   {
-    mu_draw_control_text(context, label, renderer, MU_COLOR_TEXT, opt);
+    mu_draw_control_text_len(context, label, length, renderer, MU_COLOR_TEXT, opt);
   }
   if (icon)
   {
@@ -949,6 +1221,23 @@ int mu_button_ex(mu_Context *context, const char *label, int icon, int opt)
   return res;
 }
 
+int mu_image_ex(mu_Context *context, mu_Texture texture, mu_Rectangle source,
+                mu_Color color, int opt)
+{
+  int res = 0;
+  mu_Identifier identifier = mu_get_id(context, &texture, sizeof(texture));
+  mu_Rectangle renderer = mu_layout_next(context);
+  mu_update_control(context, identifier, renderer, opt);
+  /* handle click */
+  if (context->mouse_pressed == MU_MOUSE_LEFT && context->focus == identifier)
+  {
+    res |= MU_RES_SUBMIT;
+  }
+  /* draw */
+  mu_draw_image(context, texture, source, renderer, color);
+  return res;
+}
+
 int mu_checkbox(mu_Context *context, const char *label, int *state)
 {
   int res = 0;
@@ -1032,29 +1321,51 @@ int mu_textbox_raw(mu_Context *context, char *buffer, int bufsz, mu_Identifier i
   return res;
 }
 
-static int number_textbox(mu_Context *context, mu_Real *value, mu_Rectangle renderer, mu_Identifier identifier)
+/* shift+click starts editing a number as text; the caller then formats
+** the value into number_edit_buf */
+static int number_edit_begin(mu_Context *context, mu_Identifier identifier)
 {
   if (context->mouse_pressed == MU_MOUSE_LEFT && context->key_down & MU_KEY_SHIFT &&
       context->hover == identifier)
   {
     context->number_edit = identifier;
+    return 1;
+  }
+  return 0;
+}
+
+/* -1 when not editing, 1 while the textbox is up, 0 once the text in
+** number_edit_buf should be parsed */
+static int number_edit(mu_Context *context, mu_Rectangle renderer, mu_Identifier identifier)
+{
+  int res;
+  if (context->number_edit != identifier)
+  {
+    return -1;
+  }
+  res = mu_textbox_raw(
+      context, context->number_edit_buf, sizeof(context->number_edit_buf), identifier, renderer, 0);
+  if (res & MU_RES_SUBMIT || context->focus != identifier)
+  {
+    context->number_edit = 0;
+    return 0;
+  }
+  return 1;
+}
+
+static int number_textbox(mu_Context *context, mu_Real *value, mu_Rectangle renderer, mu_Identifier identifier)
+{
+  int editing;
+  if (number_edit_begin(context, identifier))
+  {
     sprintf(context->number_edit_buf, MU_REAL_FMT, *value);
   }
-  if (context->number_edit == identifier)
+  editing = number_edit(context, renderer, identifier);
+  if (editing == 0)
   {
-    int res = mu_textbox_raw(
-        context, context->number_edit_buf, sizeof(context->number_edit_buf), identifier, renderer, 0);
-    if (res & MU_RES_SUBMIT || context->focus != identifier)
-    {
-      *value = strtod(context->number_edit_buf, NULL);
-      context->number_edit = 0;
-    }
-    else
-    {
-      return 1;
-    }
+    *value = strtod(context->number_edit_buf, NULL);
   }
-  return 0;
+  return editing == 1;
 }
 
 int mu_textbox_ex(mu_Context *context, char *buffer, int bufsz, int opt)
@@ -1152,11 +1463,312 @@ int mu_number_ex(mu_Context *context, mu_Real *value, mu_Real step,
   return res;
 }
 
-static int header(mu_Context *context, const char *label, int istreenode, int opt)
+/* decimal digits of value, without going through the float formatter */
+static int format_int64(char *buffer, long long value)
+{
+  char digits[24];
+  unsigned long long magnitude = value < 0 ? 0ull - (unsigned long long)value : (unsigned long long)value;
+  int n = 0, length = 0;
+  do
+  {
+    digits[n++] = '0' + magnitude % 10;
+    magnitude /= 10;
+  } while (magnitude);
+  if (value < 0)
+  {
+    buffer[length++] = '-';
+  }
+  while (n)
+  {
+    buffer[length++] = digits[--n];
+  }
+  buffer[length] = '\0';
+  return length;
+}
+
+/* value + delta * step, saturating at [low, high] instead of wrapping */
+static long long add_steps(long long value, int delta, long long step, long long low, long long high)
+{
+  long long product, pixels = delta < 0 ? -(long long)delta : delta;
+  if (delta == 0 || step == 0)
+  {
+    return value;
+  }
+  if (step > LLONG_MAX / pixels || step < -(LLONG_MAX / pixels))
+  {
+    return (delta > 0) == (step > 0) ? high : low;
+  }
+  product = delta * step;
+  if (product > 0 && value > high - product)
+  {
+    return high;
+  }
+  if (product < 0 && value < low - product)
+  {
+    return low;
+  }
+  return value + product;
+}
+
+static int slider_int64(mu_Context *context, mu_Identifier identifier, long long *value, long long low,
+                        long long high, long long step, int opt)
+{
+  char buffer[24];
+  mu_Rectangle thumb, base = mu_layout_next(context);
+  unsigned long long span;
+  long long last = *value, v = last;
+  int x, w, length, editing, res = 0;
+  high = mu_max(high, low);
+  span = (unsigned long long)high - (unsigned long long)low;
+
+  /* handle text input mode */
+  if (number_edit_begin(context, identifier))
+  {
+    format_int64(context->number_edit_buf, v);
+  }
+  editing = number_edit(context, base, identifier);
+  if (editing == 1)
+  {
+    return res;
+  }
+  if (editing == 0)
+  {
+    v = strtoll(context->number_edit_buf, NULL, 10);
+  }
+
+  /* handle normal mode */
+  mu_update_control(context, identifier, base, opt);
+
+  /* handle input; span / w * x + span % w * x / w is exact without overflowing */
+  if (context->focus == identifier && base.w > 0 &&
+      (context->mouse_down | context->mouse_pressed) == MU_MOUSE_LEFT)
+  {
+    unsigned long long offset = mu_clamp(context->mouse_pos.x - base.x, 0, base.w);
+    unsigned long long rel = span / base.w * offset + span % base.w * offset / base.w;
+    if (step > 1)
+    {
+      /* round to the nearest step, staying inside the range */
+      unsigned long long snapped = rel - rel % step;
+      int up = rel % step >= (unsigned long long)(step - step / 2) && span - snapped >= (unsigned long long)step;
+      rel = up ? snapped + step : snapped;
+    }
+    v = (long long)((unsigned long long)low + rel);
+  }
+  /* clamp and store value, update res */
+  *value = v = mu_clamp(v, low, high);
+  if (last != v)
+  {
+    res |= MU_RES_CHANGE;
+  }
+
+  /* draw base */
+  mu_draw_control_frame(context, identifier, base, MU_COLOR_BASE, opt);
+  /* draw thumb */
+  w = context->style->thumb_size;
+  x = span ? (int)((double)((unsigned long long)v - (unsigned long long)low) / span * (base.w - w)) : 0;
+  thumb = mu_rect(base.x + x, base.y, w, base.h);
+  mu_draw_control_frame(context, identifier, thumb, MU_COLOR_BUTTON, opt);
+  /* draw text  */
+  length = format_int64(buffer, v);
+  mu_draw_control_text_len(context, buffer, length, base, MU_COLOR_TEXT, opt);
+
+  return res;
+}
+
+static int number_int64(mu_Context *context, mu_Identifier identifier, long long *value, long long step,
+                        long long low, long long high, int opt)
+{
+  char buffer[24];
+  mu_Rectangle base = mu_layout_next(context);
+  long long last = *value;
+  int length, editing, res = 0;
+
+  /* handle text input mode */
+  if (number_edit_begin(context, identifier))
+  {
+    format_int64(context->number_edit_buf, *value);
+  }
+  editing = number_edit(context, base, identifier);
+  if (editing == 1)
+  {
+    return res;
+  }
+  if (editing == 0)
+  {
+    *value = mu_clamp(strtoll(context->number_edit_buf, NULL, 10), low, high);
+  }
+
+  /* handle normal mode */
+  mu_update_control(context, identifier, base, opt);
+
+  /* handle input */
+  if (context->focus == identifier && context->mouse_down == MU_MOUSE_LEFT)
+  {
+    *value = add_steps(*value, context->mouse_delta.x, step, low, high);
+  }
+  /* set flag if value changed */
+  if (*value != last)
+  {
+    res |= MU_RES_CHANGE;
+  }
+
+  /* draw base */
+  mu_draw_control_frame(context, identifier, base, MU_COLOR_BASE, opt);
+  /* draw text  */
+  length = format_int64(buffer, *value);
+  mu_draw_control_text_len(context, buffer, length, base, MU_COLOR_TEXT, opt);
+
+  return res;
+}
+
+int mu_slider_int_ex(mu_Context *context, int *value, int low, int high, int step, int opt)
+{
+  long long v = *value;
+  int res = slider_int64(context, mu_get_id(context, &value, sizeof(value)), &v, low, high, step, opt);
+  *value = (int)v;
+  return res;
+}
+
+int mu_number_int_ex(mu_Context *context, int *value, int step, int opt)
+{
+  long long v = *value;
+  int res = number_int64(context, mu_get_id(context, &value, sizeof(value)), &v, step, INT_MIN, INT_MAX, opt);
+  *value = (int)v;
+  return res;
+}
+
+int mu_slider_int64_ex(mu_Context *context, long long *value, long long low, long long high, long long step,
+                       int opt)
+{
+  return slider_int64(context, mu_get_id(context, &value, sizeof(value)), value, low, high, step, opt);
+}
+
+int mu_number_int64_ex(mu_Context *context, long long *value, long long step, int opt)
+{
+  return number_int64(context, mu_get_id(context, &value, sizeof(value)), value, step, LLONG_MIN, LLONG_MAX,
+                      opt);
+}
+
+/* shortest of %.15g and %.17g that reads back as the same double */
+static void format_double(char *buffer, double value)
+{
+  sprintf(buffer, "%.15g", value);
+  if (strtod(buffer, NULL) != value)
+  {
+    sprintf(buffer, "%.17g", value);
+  }
+}
+
+int mu_slider_double_ex(mu_Context *context, double *value, double low, double high, double step, const char *fmt,
+                        int opt)
+{
+  char buffer[MU_MAX_FMT + 1];
+  mu_Rectangle thumb;
+  int x, w, editing, res = 0;
+  double last = *value, v = last;
+  mu_Identifier identifier = mu_get_id(context, &value, sizeof(value));
+  mu_Rectangle base = mu_layout_next(context);
+
+  /* handle text input mode */
+  if (number_edit_begin(context, identifier))
+  {
+    format_double(context->number_edit_buf, v);
+  }
+  editing = number_edit(context, base, identifier);
+  if (editing == 1)
+  {
+    return res;
+  }
+  if (editing == 0)
+  {
+    v = strtod(context->number_edit_buf, NULL);
+  }
+
+  /* handle normal mode */
+  mu_update_control(context, identifier, base, opt);
+
+  /* handle input */
+  if (context->focus == identifier &&
+      (context->mouse_down | context->mouse_pressed) == MU_MOUSE_LEFT)
+  {
+    v = low + (context->mouse_pos.x - base.x) * (high - low) / base.w;
+    if (step)
+    {
+      v = ((long long)((v + step / 2) / step)) * step;
+    }
+  }
+  /* clamp and store value, update res */
+  *value = v = mu_clamp(v, low, high);
+  if (last != v)
+  {
+    res |= MU_RES_CHANGE;
+  }
+
+  /* draw base */
+  mu_draw_control_frame(context, identifier, base, MU_COLOR_BASE, opt);
+  /* draw thumb */
+  w = context->style->thumb_size;
+  x = (v - low) * (base.w - w) / (high - low);
+  thumb = mu_rect(base.x + x, base.y, w, base.h);
+  mu_draw_control_frame(context, identifier, thumb, MU_COLOR_BUTTON, opt);
+  /* draw text  */
+  sprintf(buffer, fmt, v);
+  mu_draw_control_text(context, buffer, base, MU_COLOR_TEXT, opt);
+
+  return res;
+}
+
+int mu_number_double_ex(mu_Context *context, double *value, double step, const char *fmt, int opt)
+{
+  char buffer[MU_MAX_FMT + 1];
+  int editing, res = 0;
+  mu_Identifier identifier = mu_get_id(context, &value, sizeof(value));
+  mu_Rectangle base = mu_layout_next(context);
+  double last = *value;
+
+  /* handle text input mode */
+  if (number_edit_begin(context, identifier))
+  {
+    format_double(context->number_edit_buf, *value);
+  }
+  editing = number_edit(context, base, identifier);
+  if (editing == 1)
+  {
+    return res;
+  }
+  if (editing == 0)
+  {
+    *value = strtod(context->number_edit_buf, NULL);
+  }
+
+  /* handle normal mode */
+  mu_update_control(context, identifier, base, opt);
+
+  /* handle input */
+  if (context->focus == identifier && context->mouse_down == MU_MOUSE_LEFT)
+  {
+    *value += context->mouse_delta.x * step;
+  }
+  /* set flag if value changed */
+  if (*value != last)
+  {
+    res |= MU_RES_CHANGE;
+  }
+
+  /* draw base */
+  mu_draw_control_frame(context, identifier, base, MU_COLOR_BASE, opt);
+  /* draw text  */
+  sprintf(buffer, fmt, *value);
+  mu_draw_control_text(context, buffer, base, MU_COLOR_TEXT, opt);
+
+  return res;
+}
+
+static int header(mu_Context *context, const char *label, int length, int istreenode, int opt)
 {
   mu_Rectangle renderer;
   int active, expanded;
-  mu_Identifier identifier = mu_get_id(context, label, strlen(label));
+  mu_Identifier identifier = mu_get_id(context, label, length);
   int idx = mu_pool_get(context, context->treenode_pool, MU_TREENODEPOOL_SIZE, identifier);
   int width = -1;
   mu_layout_row(context, 1, &width, 0);
@@ -1203,19 +1815,29 @@ static int header(mu_Context *context, const char *label, int istreenode, int op
       mu_rect(renderer.x, renderer.y, renderer.h, renderer.h), context->style->colors[MU_COLOR_TEXT]);
   renderer.x += renderer.h - context->style->padding;
   renderer.w -= renderer.h - context->style->padding;
-  mu_draw_control_text(context, label, renderer, MU_COLOR_TEXT, 0);
+  mu_draw_control_text_len(context, label, length, renderer, MU_COLOR_TEXT, 0);
 
   return expanded ? MU_RES_ACTIVE : 0;
 }
 
 int mu_header_ex(mu_Context *context, const char *label, int opt)
 {
-  return header(context, label, 0, opt);
+  return header(context, label, strlen(label), 0, opt);
+}
+
+int mu_header_len(mu_Context *context, const char *label, int length, int opt)
+{
+  return header(context, label, length, 0, opt);
 }
 
 int mu_begin_treenode_ex(mu_Context *context, const char *label, int opt)
 {
-  int res = header(context, label, 1, opt);
+  return mu_begin_treenode_len(context, label, strlen(label), opt);
+}
+
+int mu_begin_treenode_len(mu_Context *context, const char *label, int length, int opt)
+{
+  int res = header(context, label, length, 1, opt);
   if (res & MU_RES_ACTIVE)
   {
     get_layout(context)->indentation += context->style->indentation;
@@ -1250,7 +1872,7 @@ void mu_end_treenode(mu_Context *context)
       mu_update_control(context, identifier, base, 0);                          \
       if (context->focus == identifier && context->mouse_down == MU_MOUSE_LEFT)     \
       {                                                                     \
-        cnt->scroll.y += context->mouse_delta.y * cs.y / base.h;                \
+        cnt->scroll.y += (long long)context->mouse_delta.y * cs.y / base.h;     \
       }                                                                     \
       /* clamp scroll to limits */                                          \
       cnt->scroll.y = mu_clamp(cnt->scroll.y, 0, maxscroll);                \
@@ -1259,7 +1881,7 @@ void mu_end_treenode(mu_Context *context)
       context->draw_frame(context, base, MU_COLOR_SCROLLBASE);                      \
       thumb = base;                                                         \
       thumb.h = mu_max(context->style->thumb_size, base.h * b->h / cs.y);       \
-      thumb.y += cnt->scroll.y * (base.h - thumb.h) / maxscroll;            \
+      thumb.y += (long long)cnt->scroll.y * (base.h - thumb.h) / maxscroll; \
       context->draw_frame(context, thumb, MU_COLOR_SCROLLTHUMB);                    \
                                                                             \
       /* set this as the scroll_target (will get scrolled on mousewheel) */ \
@@ -1341,9 +1963,14 @@ static void end_root_container(mu_Context *context)
 }
 
 int mu_begin_window_ex(mu_Context *context, const char *title, mu_Rectangle rectangle, int opt)
+{
+  return mu_begin_window_len(context, title, strlen(title), rectangle, opt);
+}
+
+int mu_begin_window_len(mu_Context *context, const char *title, int length, mu_Rectangle rectangle, int opt)
 {
   mu_Rectangle body;
-  mu_Identifier identifier = mu_get_id(context, title, strlen(title));
+  mu_Identifier identifier = mu_get_id(context, title, length);
   mu_Container *cnt = get_container(context, identifier, opt);
   if (!cnt || !cnt->open)
   {
@@ -1376,7 +2003,7 @@ int mu_begin_window_ex(mu_Context *context, const char *title, mu_Rectangle rect
     {
       mu_Identifier identifier = mu_get_id(context, "!title", 6);
       mu_update_control(context, identifier, tr, opt);
-      mu_draw_control_text(context, title, tr, MU_COLOR_TITLETEXT, opt);
+      mu_draw_control_text_len(context, title, length, tr, MU_COLOR_TITLETEXT, opt);
       if (identifier == context->focus && context->mouse_down == MU_MOUSE_LEFT)
       {
         cnt->rectangle.x += context->mouse_delta.x;
@@ -1465,9 +2092,14 @@ void mu_end_popup(mu_Context *context)
 }
 
 void mu_begin_panel_ex(mu_Context *context, const char *name, int opt)
+{
+  mu_begin_panel_len(context, name, strlen(name), opt);
+}
+
+void mu_begin_panel_len(mu_Context *context, const char *name, int length, int opt)
 {
   mu_Container *cnt;
-  mu_push_id(context, name, strlen(name));
+  mu_push_id(context, name, length);
   cnt = get_container(context, context->last_identifier, opt);
   cnt->rectangle = mu_layout_next(context);
   if (~opt & MU_OPT_NOFRAME)
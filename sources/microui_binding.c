@@ -0,0 +1,153 @@
+/**
+ * @file microui_binding.c
+ * @brief Implementation of seqlock-protected live data binding
+ *
+ * Writer: bump the sequence to an odd value, store the payload, then bump it
+ * back to an even value with release ordering. Reader: load the sequence,
+ * copy the payload, and accept the copy only if the sequence was even and did
+ * not move in between. Payload words are accessed with relaxed atomics so the
+ * concurrent copy is well defined.
+ */
+
+#include <string.h>
+
+#include "microui_binding.h"
+
+enum
+{
+  WORDS = MU_BINDING_SIZE / 8
+};
+
+void mu_binding_init(mu_Binding *binding)
+{
+  int i;
+  atomic_init(&binding->sequence, 0);
+  for (i = 0; i < WORDS; i++)
+  {
+    atomic_init(&binding->payload[i], 0);
+  }
+  binding->seen = 0;
+  binding->version = 0;
+  memset(&binding->value, 0, sizeof(binding->value));
+}
+
+/*============================================================================
+** producer
+**============================================================================*/
+
+void mu_binding_publish(mu_Binding *binding, const void *data, int size)
+{
+  mu_BindingValue value;
+  unsigned sequence;
+  int i;
+  memset(&value, 0, sizeof(value));
+  memcpy(&value, data, mu_clamp(size, 0, MU_BINDING_SIZE));
+
+  sequence = atomic_load_explicit(&binding->sequence, memory_order_relaxed);
+  atomic_store_explicit(&binding->sequence, sequence + 1, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  for (i = 0; i < WORDS; i++)
+  {
+    atomic_store_explicit(&binding->payload[i], value.words[i], memory_order_relaxed);
+  }
+  atomic_store_explicit(&binding->sequence, sequence + 2, memory_order_release);
+}
+
+void mu_binding_publish_real(mu_Binding *binding, mu_Real value)
+{
+  mu_binding_publish(binding, &value, sizeof(value));
+}
+
+void mu_binding_publish_text(mu_Binding *binding, const char *text)
+{
+  int length = mu_min((int)strlen(text), MU_BINDING_SIZE - 1);
+  mu_binding_publish(binding, text, length);
+}
+
+/*============================================================================
+** reader
+**============================================================================*/
+
+int mu_binding_sync(mu_Binding *binding)
+{
+  mu_BindingValue value;
+  unsigned before, after;
+  int attempt, i;
+  for (attempt = 0; attempt < MU_BINDING_RETRIES; attempt++)
+  {
+    before = atomic_load_explicit(&binding->sequence, memory_order_acquire);
+    if (before == binding->seen)
+    {
+      return 0;
+    }
+    if (before & 1)
+    {
+      continue;
+    }
+    for (i = 0; i < WORDS; i++)
+    {
+      value.words[i] = atomic_load_explicit(&binding->payload[i], memory_order_relaxed);
+    }
+    atomic_thread_fence(memory_order_acquire);
+    after = atomic_load_explicit(&binding->sequence, memory_order_relaxed);
+    if (before == after)
+    {
+      value.text[MU_BINDING_SIZE - 1] = '\0';
+      binding->seen = before;
+      if (memcmp(&value, &binding->value, sizeof(value)) == 0)
+      {
+        return 0;
+      }
+      binding->value = value;
+      binding->version++;
+      return 1;
+    }
+  }
+  /* producer is mid-write: keep the previous snapshot rather than wait */
+  return 0;
+}
+
+int mu_binding_changed(mu_Binding *binding, unsigned *version)
+{
+  int changed = (*version != binding->version);
+  *version = binding->version;
+  return changed;
+}
+
+/*============================================================================
+** widgets
+**============================================================================*/
+
+static int is_editing(mu_Context *context, mu_Binding *binding)
+{
+  /* same identifier mu_slider_ex/mu_number_ex derive from the value pointer */
+  mu_Real *value = &binding->value.real;
+  mu_Identifier identifier = mu_get_id(context, &value, sizeof(value));
+  return context->focus == identifier || context->number_edit == identifier;
+}
+
+int mu_bound_slider_ex(mu_Context *context, mu_Binding *binding, mu_Real low, mu_Real high,
+                       mu_Real step, const char *fmt, int opt)
+{
+  if (!is_editing(context, binding))
+  {
+    mu_binding_sync(binding);
+  }
+  return mu_slider_ex(context, &binding->value.real, low, high, step, fmt, opt);
+}
+
+int mu_bound_number_ex(mu_Context *context, mu_Binding *binding, mu_Real step,
+                       const char *fmt, int opt)
+{
+  if (!is_editing(context, binding))
+  {
+    mu_binding_sync(binding);
+  }
+  return mu_number_ex(context, &binding->value.real, step, fmt, opt);
+}
+
+void mu_bound_label(mu_Context *context, mu_Binding *binding)
+{
+  mu_binding_sync(binding);
+  mu_label(context, binding->value.text);
+}
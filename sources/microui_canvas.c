@@ -0,0 +1,324 @@
+/**
+ * @file microui_canvas.c
+ * @brief Implementation of the pan/zoom canvas and its item grid
+ *
+ * Items are keyed by the cell holding their top-left corner, so an item
+ * is stored exactly once however large it is. A query therefore also has
+ * to visit the cells up to the largest item size to the left of and above
+ * the queried rectangle; the per-cell bounds let it skip those cells
+ * without touching their items.
+ */
+
+#include <string.h>
+
+#include "microui_canvas.h"
+
+/* multiplier for one wheel step */
+#define ZOOM_STEP 1.25f
+
+/*============================================================================
+** grid
+**============================================================================*/
+
+static int floor_div(int a, int b)
+{
+  return a / b - (a % b < 0);
+}
+
+static int floor_int(mu_Real value)
+{
+  int i = (int)value;
+  return i - (value < i);
+}
+
+static int overlaps(mu_Rectangle a, mu_Rectangle b)
+{
+  return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+static mu_Rectangle merge(mu_Rectangle a, mu_Rectangle b)
+{
+  int x1 = mu_min(a.x, b.x), y1 = mu_min(a.y, b.y);
+  int x2 = mu_max(a.x + a.w, b.x + b.w), y2 = mu_max(a.y + a.h, b.y + b.h);
+  return mu_rect(x1, y1, x2 - x1, y2 - y1);
+}
+
+/* slot of cell (x, y), creating it if asked; -1 if absent or full */
+static int find_cell(mu_Canvas *canvas, int x, int y, int create)
+{
+  unsigned mask = canvas->cell_capacity - 1;
+  unsigned slot = ((unsigned)x * 73856093u ^ (unsigned)y * 19349663u) & mask;
+  while (canvas->cells[slot].used)
+  {
+    if (canvas->cells[slot].x == x && canvas->cells[slot].y == y)
+    {
+      return slot;
+    }
+    slot = (slot + 1) & mask;
+  }
+  /* keep the table under 3/4 load so probes stay short */
+  if (!create || (canvas->cell_count + 1) * 4 > canvas->cell_capacity * 3)
+  {
+    return -1;
+  }
+  canvas->cells[slot].x = x;
+  canvas->cells[slot].y = y;
+  canvas->cells[slot].used = 1;
+  canvas->cells[slot].first = -1;
+  canvas->cell_count++;
+  return slot;
+}
+
+static int cell_of(mu_Canvas *canvas, mu_Rectangle bounds, int create)
+{
+  return find_cell(canvas, floor_div(bounds.x, canvas->cell_size), floor_div(bounds.y, canvas->cell_size), create);
+}
+
+static void link(mu_Canvas *canvas, int item, int slot, mu_Rectangle bounds)
+{
+  mu_CanvasItem *it = &canvas->items[item];
+  mu_CanvasCell *cell = &canvas->cells[slot];
+  it->bounds = bounds;
+  it->cell = slot;
+  it->prev = -1;
+  it->next = cell->first;
+  if (cell->first >= 0)
+  {
+    canvas->items[cell->first].prev = item;
+  }
+  cell->bounds = cell->used > 1 ? merge(cell->bounds, bounds) : bounds;
+  cell->used = 2;
+  cell->first = item;
+  canvas->max_w = mu_max(canvas->max_w, bounds.w);
+  canvas->max_h = mu_max(canvas->max_h, bounds.h);
+}
+
+static void unlink(mu_Canvas *canvas, int item)
+{
+  mu_CanvasItem *it = &canvas->items[item];
+  if (it->prev >= 0)
+  {
+    canvas->items[it->prev].next = it->next;
+  }
+  else
+  {
+    canvas->cells[it->cell].first = it->next;
+  }
+  if (it->next >= 0)
+  {
+    canvas->items[it->next].prev = it->prev;
+  }
+}
+
+void mu_canvas_init(mu_Canvas *canvas, mu_CanvasItem *items, int item_capacity, mu_CanvasCell *cells,
+                    int cell_capacity, int cell_size)
+{
+  memset(canvas, 0, sizeof(*canvas));
+  canvas->items = items;
+  canvas->item_capacity = item_capacity;
+  canvas->cells = cells;
+  canvas->cell_capacity = cell_capacity;
+  canvas->cell_size = mu_max(cell_size, 1);
+  canvas->zoom = 1;
+  canvas->hovered = -1;
+  mu_canvas_clear(canvas);
+}
+
+void mu_canvas_clear(mu_Canvas *canvas)
+{
+  memset(canvas->cells, 0, canvas->cell_capacity * sizeof(*canvas->cells));
+  canvas->cell_count = 0;
+  canvas->item_count = 0;
+  canvas->max_w = canvas->max_h = 0;
+  canvas->hovered = -1;
+  canvas->visible.scan = 1;
+  canvas->visible.slot = canvas->cell_capacity;
+  canvas->visible.item = -1;
+}
+
+int mu_canvas_add(mu_Canvas *canvas, mu_Rectangle bounds)
+{
+  int slot;
+  if (canvas->item_count == canvas->item_capacity || (slot = cell_of(canvas, bounds, 1)) < 0)
+  {
+    return -1;
+  }
+  link(canvas, canvas->item_count, slot, bounds);
+  return canvas->item_count++;
+}
+
+int mu_canvas_move(mu_Canvas *canvas, int item, mu_Rectangle bounds)
+{
+  int slot = cell_of(canvas, bounds, 1);
+  if (slot < 0)
+  {
+    return 0;
+  }
+  unlink(canvas, item);
+  link(canvas, item, slot, bounds);
+  return 1;
+}
+
+/*============================================================================
+** queries
+**============================================================================*/
+
+void mu_canvas_query(mu_Canvas *canvas, mu_CanvasQuery *query, mu_Rectangle rectangle)
+{
+  long long cells;
+  query->rectangle = rectangle;
+  query->item = -1;
+  query->x1 = floor_div(rectangle.x - canvas->max_w, canvas->cell_size);
+  query->y1 = floor_div(rectangle.y - canvas->max_h, canvas->cell_size);
+  query->x2 = floor_div(rectangle.x + rectangle.w - 1, canvas->cell_size);
+  query->y2 = floor_div(rectangle.y + rectangle.h - 1, canvas->cell_size);
+  query->cx = query->x1 - 1;
+  query->cy = query->y1;
+
+  /* when zoomed far out, scanning every cell beats probing empty ones */
+  cells = (long long)(query->x2 - query->x1 + 1) * (query->y2 - query->y1 + 1);
+  query->scan = cells > canvas->cell_count;
+  query->slot = -1;
+  if (rectangle.w <= 0 || rectangle.h <= 0)
+  {
+    query->scan = 1;
+    query->slot = canvas->cell_capacity;
+  }
+}
+
+int mu_canvas_query_next(mu_Canvas *canvas, mu_CanvasQuery *query)
+{
+  for (;;)
+  {
+    int slot;
+    while (query->item >= 0)
+    {
+      int item = query->item;
+      query->item = canvas->items[item].next;
+      if (overlaps(canvas->items[item].bounds, query->rectangle))
+      {
+        return item;
+      }
+    }
+
+    /* advance to the next cell whose items may reach the rectangle */
+    if (query->scan)
+    {
+      if (query->slot >= canvas->cell_capacity - 1)
+      {
+        query->slot = canvas->cell_capacity;
+        return -1;
+      }
+      slot = ++query->slot;
+      if (!canvas->cells[slot].used)
+      {
+        continue;
+      }
+    }
+    else
+    {
+      if (++query->cx > query->x2)
+      {
+        query->cx = query->x1;
+        query->cy++;
+      }
+      if (query->cy > query->y2)
+      {
+        query->cx = query->x2;
+        return -1;
+      }
+      slot = find_cell(canvas, query->cx, query->cy, 0);
+      if (slot < 0)
+      {
+        continue;
+      }
+    }
+    if (overlaps(canvas->cells[slot].bounds, query->rectangle))
+    {
+      query->item = canvas->cells[slot].first;
+    }
+  }
+}
+
+int mu_canvas_hit(mu_Canvas *canvas, mu_Vector2 point)
+{
+  mu_CanvasQuery query;
+  int item, best = -1;
+  mu_canvas_query(canvas, &query, mu_rect(point.x, point.y, 1, 1));
+  while ((item = mu_canvas_query_next(canvas, &query)) >= 0)
+  {
+    best = mu_max(best, item);
+  }
+  return best;
+}
+
+/*============================================================================
+** view
+**============================================================================*/
+
+mu_Rectangle mu_canvas_rect(mu_Canvas *canvas, mu_Rectangle world)
+{
+  int x1 = floor_int((world.x - canvas->pan_x) * canvas->zoom);
+  int y1 = floor_int((world.y - canvas->pan_y) * canvas->zoom);
+  int x2 = floor_int((world.x + world.w - canvas->pan_x) * canvas->zoom);
+  int y2 = floor_int((world.y + world.h - canvas->pan_y) * canvas->zoom);
+  return mu_rect(canvas->body.x + x1, canvas->body.y + y1, x2 - x1, y2 - y1);
+}
+
+mu_Vector2 mu_canvas_point(mu_Canvas *canvas, mu_Vector2 screen)
+{
+  return mu_vec2(floor_int(canvas->pan_x + (screen.x - canvas->body.x) / canvas->zoom),
+                 floor_int(canvas->pan_y + (screen.y - canvas->body.y) / canvas->zoom));
+}
+
+int mu_begin_canvas_ex(mu_Context *context, const char *name, mu_Canvas *canvas, int opt)
+{
+  mu_Identifier identifier = mu_get_id(context, &canvas, sizeof(canvas));
+  mu_Vector2 mouse = context->mouse_pos;
+  mu_Rectangle view;
+  int res = 0;
+
+  mu_begin_panel_ex(context, name, opt | MU_OPT_NOSCROLL);
+  canvas->body = mu_get_current_container(context)->body;
+  mu_update_control(context, identifier, canvas->body, opt);
+
+  /* drag with any button to pan */
+  if (context->focus == identifier && context->mouse_down && (context->mouse_delta.x || context->mouse_delta.y))
+  {
+    canvas->pan_x -= context->mouse_delta.x / canvas->zoom;
+    canvas->pan_y -= context->mouse_delta.y / canvas->zoom;
+    res |= MU_RES_CHANGE;
+  }
+
+  /* wheel zooms around the cursor; take the wheel so no parent scrolls too */
+  if (mu_mouse_over(context, canvas->body) && context->scroll_delta.y)
+  {
+    mu_Real x = canvas->pan_x + (mouse.x - canvas->body.x) / canvas->zoom;
+    mu_Real y = canvas->pan_y + (mouse.y - canvas->body.y) / canvas->zoom;
+    canvas->zoom *= context->scroll_delta.y < 0 ? ZOOM_STEP : 1 / ZOOM_STEP;
+    canvas->zoom = mu_clamp(canvas->zoom, MU_CANVAS_MIN_ZOOM, MU_CANVAS_MAX_ZOOM);
+    canvas->pan_x = x - (mouse.x - canvas->body.x) / canvas->zoom;
+    canvas->pan_y = y - (mouse.y - canvas->body.y) / canvas->zoom;
+    context->scroll_delta = mu_vec2(0, 0);
+    res |= MU_RES_CHANGE;
+  }
+
+  canvas->hovered = mu_mouse_over(context, canvas->body) ? mu_canvas_hit(canvas, mu_canvas_point(canvas, mouse)) : -1;
+
+  /* the world rectangle under the body, rounded outwards */
+  view = mu_rect(floor_int(canvas->pan_x), floor_int(canvas->pan_y), 0, 0);
+  view.w = floor_int(canvas->pan_x + canvas->body.w / canvas->zoom) + 1 - view.x;
+  view.h = floor_int(canvas->pan_y + canvas->body.h / canvas->zoom) + 1 - view.y;
+  mu_canvas_query(canvas, &canvas->visible, view);
+  return res;
+}
+
+int mu_canvas_next(mu_Canvas *canvas)
+{
+  return mu_canvas_query_next(canvas, &canvas->visible);
+}
+
+void mu_end_canvas(mu_Context *context)
+{
+  mu_end_panel(context);
+}
@@ -0,0 +1,297 @@
+/**
+ * @file microui_chart.c
+ * @brief Implementation of the decimating time-series chart
+ *
+ * Decimation maps the visible sample window onto the chart's pixel columns.
+ * Each column stores the min/max of its samples (plus the last sample of the
+ * previous column, so adjacent columns always connect). The inner min/max
+ * scan is vectorized where SSE or NEON is available. The result is drawn as
+ * a single MU_COMMAND_LINES polyline.
+ */
+
+#include <string.h>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define MU_CHART_SSE
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MU_CHART_NEON
+#endif
+
+#include "microui_chart.h"
+
+/*============================================================================
+** series
+**============================================================================*/
+
+void mu_series_init(mu_Series *series, float *storage, int capacity)
+{
+  memset(series, 0, sizeof(*series));
+  series->samples = storage;
+  series->capacity = capacity;
+}
+
+void mu_series_push(mu_Series *series, const float *values, int count)
+{
+  /* only the newest `capacity` samples can survive */
+  if (count > series->capacity)
+  {
+    values += count - series->capacity;
+    count = series->capacity;
+  }
+  while (count > 0)
+  {
+    int end = (series->start + series->count) % series->capacity;
+    int n = mu_min(count, series->capacity - end);
+    memcpy(series->samples + end, values, n * sizeof(*values));
+    series->count += n;
+    if (series->count > series->capacity)
+    {
+      series->start = (series->start + series->count - series->capacity) % series->capacity;
+      series->count = series->capacity;
+    }
+    values += n;
+    count -= n;
+  }
+  series->version++;
+}
+
+float mu_series_get(const mu_Series *series, int idx)
+{
+  return series->samples[(series->start + idx) % series->capacity];
+}
+
+/*============================================================================
+** decimation
+**============================================================================*/
+
+static void span_minmax(const float *p, int n, float *lo, float *hi)
+{
+  float l = *lo, h = *hi;
+#if defined(MU_CHART_SSE)
+  if (n >= 8)
+  {
+    float tmp[4];
+    int i;
+    __m128 vl = _mm_set1_ps(l), vh = _mm_set1_ps(h);
+    for (; n >= 4; n -= 4, p += 4)
+    {
+      __m128 v = _mm_loadu_ps(p);
+      vl = _mm_min_ps(vl, v);
+      vh = _mm_max_ps(vh, v);
+    }
+    _mm_storeu_ps(tmp, vl);
+    for (i = 0; i < 4; i++)
+    {
+      l = mu_min(l, tmp[i]);
+    }
+    _mm_storeu_ps(tmp, vh);
+    for (i = 0; i < 4; i++)
+    {
+      h = mu_max(h, tmp[i]);
+    }
+  }
+#elif defined(MU_CHART_NEON)
+  if (n >= 8)
+  {
+    float32x4_t vl = vdupq_n_f32(l), vh = vdupq_n_f32(h);
+    for (; n >= 4; n -= 4, p += 4)
+    {
+      float32x4_t v = vld1q_f32(p);
+      vl = vminq_f32(vl, v);
+      vh = vmaxq_f32(vh, v);
+    }
+    l = vminvq_f32(vl);
+    h = vmaxvq_f32(vh);
+  }
+#endif
+  for (; n > 0; n--, p++)
+  {
+    l = mu_min(l, *p);
+    h = mu_max(h, *p);
+  }
+  *lo = l;
+  *hi = h;
+}
+
+static void range_minmax(const mu_Series *series, int first, int count, float *lo, float *hi)
+{
+  /* a range of the ring buffer is at most two contiguous spans */
+  int idx = (series->start + first) % series->capacity;
+  while (count > 0)
+  {
+    int n = mu_min(count, series->capacity - idx);
+    span_minmax(series->samples + idx, n, lo, hi);
+    count -= n;
+    idx = 0;
+  }
+}
+
+static void decimate_minmax(mu_Chart *chart, const mu_Series *series, int first, int count, int width)
+{
+  int c;
+  for (c = 0; c < width; c++)
+  {
+    int a = first + (int)((long long)c * count / width);
+    int b = first + (int)((long long)(c + 1) * count / width);
+    b = mu_max(b, a + 1);
+    /* overlap the previous column by one sample so the trace is connected */
+    if (a > first)
+    {
+      a--;
+    }
+    chart->mins[c] = chart->maxs[c] = mu_series_get(series, a);
+    range_minmax(series, a, b - a, &chart->mins[c], &chart->maxs[c]);
+  }
+}
+
+static void decimate_lttb(mu_Chart *chart, const mu_Series *series, int first, int count, int width)
+{
+  double every = (double)(count - 2) / (width - 2);
+  int a = 0, c;
+  chart->mins[0] = chart->maxs[0] = mu_series_get(series, first);
+  for (c = 0; c < width - 2; c++)
+  {
+    /* average of the next bucket is the third triangle vertex */
+    int ns = (int)((c + 1) * every) + 1;
+    int ne = mu_min((int)((c + 2) * every) + 1, count);
+    int bs = (int)(c * every) + 1;
+    int be = (int)((c + 1) * every) + 1;
+    double ax = a, ay = mu_series_get(series, first + a);
+    double cx = 0, cy = 0, best = -1;
+    int i, pick = bs;
+    if (ne <= ns)
+    {
+      ns = count - 1;
+      ne = count;
+    }
+    for (i = ns; i < ne; i++)
+    {
+      cx += i;
+      cy += mu_series_get(series, first + i);
+    }
+    cx /= ne - ns;
+    cy /= ne - ns;
+    for (i = bs; i < be; i++)
+    {
+      double py = mu_series_get(series, first + i);
+      double area = (ax - cx) * (py - ay) - (ax - i) * (cy - ay);
+      area = area < 0 ? -area : area;
+      if (area > best)
+      {
+        best = area;
+        pick = i;
+      }
+    }
+    a = pick;
+    chart->mins[c + 1] = chart->maxs[c + 1] = mu_series_get(series, first + a);
+  }
+  chart->mins[width - 1] = chart->maxs[width - 1] = mu_series_get(series, first + count - 1);
+}
+
+static void update_cache(mu_Chart *chart, const mu_Series *series, int first, int count, int width, int opt)
+{
+  opt &= MU_CHART_LTTB;
+  if (chart->cached_version == series->version && chart->cached_width == width &&
+      chart->cached_first == first && chart->cached_count == count &&
+      chart->cached_opt == opt)
+  {
+    return;
+  }
+  if (opt & MU_CHART_LTTB && count > width && width >= 3)
+  {
+    decimate_lttb(chart, series, first, count, width);
+  }
+  else
+  {
+    decimate_minmax(chart, series, first, count, width);
+  }
+  chart->cached_version = series->version;
+  chart->cached_width = width;
+  chart->cached_first = first;
+  chart->cached_count = count;
+  chart->cached_opt = opt;
+}
+
+/*============================================================================
+** widget
+**============================================================================*/
+
+void mu_chart_init(mu_Chart *chart, float low, float high)
+{
+  memset(chart, 0, sizeof(*chart));
+  chart->low = low;
+  chart->high = high;
+  chart->cached_width = -1;
+}
+
+int mu_chart_ex(mu_Context *context, mu_Chart *chart, const mu_Series *series, mu_Color color, int opt)
+{
+  mu_Vector2 points[MU_CHART_MAX_COLUMNS * 2];
+  int res = 0, span, first, width, bottom, c, n = 0;
+  float low = chart->low, high = chart->high, scale;
+  mu_Identifier identifier = mu_get_id(context, &chart, sizeof(chart));
+  mu_Rectangle base = mu_layout_next(context);
+  mu_update_control(context, identifier, base, opt);
+  mu_draw_control_frame(context, identifier, base, MU_COLOR_BASE, opt);
+
+  width = mu_min(base.w, MU_CHART_MAX_COLUMNS);
+  if (series->count == 0 || width <= 0 || base.h <= 0)
+  {
+    return res;
+  }
+
+  /* resolve the visible window; dragging pans it */
+  span = chart->span > 0 ? mu_min(chart->span, series->count) : series->count;
+  if (context->focus == identifier && context->mouse_down == MU_MOUSE_LEFT && context->mouse_delta.x)
+  {
+    /* in 64 bits: a long series times a fast drag overflows an int */
+    long long offset = chart->offset + (long long)context->mouse_delta.x * span / width;
+    chart->offset = (int)mu_clamp(offset, 0, series->count - span);
+    res |= MU_RES_CHANGE;
+  }
+  chart->offset = mu_clamp(chart->offset, 0, series->count - span);
+  first = series->count - span - chart->offset;
+
+  update_cache(chart, series, first, span, width, opt);
+
+  if (opt & MU_CHART_AUTOSCALE)
+  {
+    low = chart->mins[0];
+    high = chart->maxs[0];
+    for (c = 1; c < width; c++)
+    {
+      low = mu_min(low, chart->mins[c]);
+      high = mu_max(high, chart->maxs[c]);
+    }
+  }
+  if (high <= low)
+  {
+    high = low + 1;
+  }
+
+  /* emit the whole trace as one polyline; min/max columns zigzag so that
+  ** consecutive columns join at their nearest ends */
+  scale = (base.h - 1) / (high - low);
+  bottom = base.y + base.h - 1;
+  for (c = 0; c < width; c++)
+  {
+    int top = bottom - (int)((chart->maxs[c] - low) * scale);
+    int bot = bottom - (int)((chart->mins[c] - low) * scale);
+    if (top == bot)
+    {
+      points[n++] = mu_vec2(base.x + c, top);
+    }
+    else
+    {
+      points[n++] = mu_vec2(base.x + c, (c & 1) ? bot : top);
+      points[n++] = mu_vec2(base.x + c, (c & 1) ? top : bot);
+    }
+  }
+  mu_push_clip_rect(context, base);
+  mu_draw_lines(context, points, n, color);
+  mu_pop_clip_rect(context);
+
+  return res;
+}
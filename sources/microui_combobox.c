@@ -0,0 +1,261 @@
+/**
+ * @file microui_combobox.c
+ * @brief Implementation of the searchable combobox
+ *
+ * Items are ordered by their text with ASCII letters folded to lower case,
+ * which puts every item sharing a folded prefix next to each other. The
+ * index is built with an in-place heap sort so the widget needs no storage
+ * beyond the order array.
+ */
+
+#include <string.h>
+
+#include "microui_combobox.h"
+
+/*============================================================================
+** index
+**============================================================================*/
+
+static int fold(const char *text, int i)
+{
+  int c = (unsigned char)text[i];
+  return c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c;
+}
+
+static int compare_text(const char *a, const char *b)
+{
+  int i = 0;
+  while (a[i] && fold(a, i) == fold(b, i))
+  {
+    i++;
+  }
+  return fold(a, i) - fold(b, i);
+}
+
+/* compare the first `length` bytes of text with prefix; a shorter text
+** sorts before it */
+static int compare_prefix(const char *text, const char *prefix, int length)
+{
+  for (int i = 0; i < length; i++)
+  {
+    int a = fold(text, i), b = fold(prefix, i);
+    if (a != b)
+    {
+      return a - b;
+    }
+  }
+  return 0;
+}
+
+static int item_less(mu_ComboBox *combo, int a, int b)
+{
+  return compare_text(combo->items[combo->order[a]], combo->items[combo->order[b]]) < 0;
+}
+
+static void sift_down(mu_ComboBox *combo, int root, int end)
+{
+  int child;
+  while ((child = root * 2 + 1) < end)
+  {
+    int swap;
+    if (child + 1 < end && item_less(combo, child, child + 1))
+    {
+      child++;
+    }
+    if (!item_less(combo, root, child))
+    {
+      return;
+    }
+    swap = combo->order[root];
+    combo->order[root] = combo->order[child];
+    combo->order[child] = swap;
+    root = child;
+  }
+}
+
+static void sort(mu_ComboBox *combo)
+{
+  int i;
+  for (i = combo->count / 2 - 1; i >= 0; i--)
+  {
+    sift_down(combo, i, combo->count);
+  }
+  for (i = combo->count - 1; i > 0; i--)
+  {
+    int swap = combo->order[0];
+    combo->order[0] = combo->order[i];
+    combo->order[i] = swap;
+    sift_down(combo, 0, i);
+  }
+}
+
+/* first position in [low, high) whose text compares above the prefix, or
+** at or above it when `upper` is zero */
+static int bound(mu_ComboBox *combo, int low, int high, const char *prefix, int length, int upper)
+{
+  while (low < high)
+  {
+    int mid = low + (high - low) / 2;
+    int c = compare_prefix(combo->items[combo->order[mid]], prefix, length);
+    if (c < 0 || (upper && c == 0))
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+static void filter(mu_ComboBox *combo)
+{
+  const char *query = combo->field.buffer;
+  int length = combo->field.length, narrowed = strlen(combo->filtered);
+  int low = 0, high = combo->count;
+  /* a query that extends the last one only matches inside its range */
+  if (length >= narrowed && compare_prefix(query, combo->filtered, narrowed) == 0)
+  {
+    low = combo->first;
+    high = combo->last;
+  }
+  combo->first = bound(combo, low, high, query, length, 0);
+  combo->last = bound(combo, combo->first, high, query, length, 1);
+  memcpy(combo->filtered, query, length + 1);
+  combo->highlight = 0;
+  combo->jump = 1;
+}
+
+void mu_combobox_init(mu_ComboBox *combo, const char **items, int *order, int count)
+{
+  memset(combo, 0, sizeof(*combo));
+  combo->items = items;
+  combo->order = order;
+  combo->count = count;
+  for (int i = 0; i < count; i++)
+  {
+    order[i] = i;
+  }
+  sort(combo);
+  mu_textfield_init(&combo->field, combo->text, sizeof(combo->text), combo->widths);
+  combo->last = count;
+  combo->selected = -1;
+}
+
+/*============================================================================
+** widget
+**============================================================================*/
+
+static void choose(mu_ComboBox *combo, int match)
+{
+  combo->selected = combo->order[combo->first + match];
+  mu_textfield_set_text(&combo->field, combo->items[combo->selected], -1);
+  combo->open = 0;
+}
+
+/* draw the rows of the matches inside the clip rect; returns the match
+** clicked, or -1 */
+static int dropdown(mu_Context *context, mu_ComboBox *combo)
+{
+  mu_Style *style = context->style;
+  mu_Container *container = mu_get_current_container(context);
+  int text_height = context->text_height(style->font);
+  int row_height = text_height + style->padding;
+  int matches = combo->last - combo->first, hovered = -1, first, last, i;
+  mu_Rectangle area;
+
+  if (combo->jump)
+  {
+    int y = combo->highlight * row_height + style->padding;
+    container->scroll.y = mu_clamp(container->scroll.y, y + row_height - container->body.h, y);
+    combo->jump = 0;
+  }
+
+  area = mu_layout_rows(context, matches, row_height, &first, &last);
+  if (mu_mouse_over(context, area))
+  {
+    hovered = (context->mouse_pos.y - area.y) / row_height;
+  }
+
+  for (i = first; i < last; i++)
+  {
+    mu_Rectangle row = mu_rect(area.x, area.y + i * row_height, area.w, row_height);
+    if (i == hovered || i == combo->highlight)
+    {
+      mu_draw_rect(context, row, style->colors[i == hovered ? MU_COLOR_BUTTONHOVER : MU_COLOR_BUTTON]);
+    }
+    mu_draw_text(context, style->font, combo->items[combo->order[combo->first + i]], -1,
+                 mu_vec2(row.x + style->padding, row.y + (row_height - text_height) / 2),
+                 style->colors[MU_COLOR_TEXT]);
+  }
+  return context->mouse_pressed & MU_MOUSE_LEFT ? hovered : -1;
+}
+
+int mu_combobox_ex(mu_Context *context, const char *name, mu_ComboBox *combo, int opt)
+{
+  mu_Style *style = context->style;
+  mu_TextField *field = &combo->field;
+  mu_Identifier identifier = mu_get_id(context, &field, sizeof(field));
+  int row_height = context->text_height(style->font) + style->padding;
+  int res = 0, edit, matches;
+  mu_Rectangle anchor;
+
+  edit = mu_textfield_ex(context, field, opt);
+  anchor = context->last_rect;
+  if (strcmp(field->buffer, combo->filtered))
+  {
+    filter(combo);
+  }
+  matches = combo->last - combo->first;
+
+  /* typing or clicking the field opens the dropdown */
+  if (edit & MU_RES_CHANGE || (context->mouse_pressed & MU_MOUSE_LEFT && mu_mouse_over(context, anchor)))
+  {
+    mu_open_popup(context, name);
+    combo->open = 1;
+  }
+  if (context->focus == identifier)
+  {
+    int step = !!(context->key_pressed & MU_KEY_DOWN) - !!(context->key_pressed & MU_KEY_UP);
+    if (step)
+    {
+      combo->highlight += step;
+      combo->jump = 1;
+    }
+  }
+  combo->highlight = mu_clamp(combo->highlight, 0, mu_max(matches - 1, 0));
+  if (edit & MU_RES_SUBMIT && combo->open && matches > 0)
+  {
+    choose(combo, combo->highlight);
+    res |= MU_RES_CHANGE;
+  }
+  if (!combo->open)
+  {
+    return res;
+  }
+
+  /* the dropdown hangs below the field, sized to the matches */
+  {
+    mu_Container *popup = mu_get_container(context, name);
+    int rows = mu_min(matches, MU_COMBOBOX_ROWS);
+    popup->rectangle = mu_rect(anchor.x, anchor.y + anchor.h, anchor.w, rows * row_height + style->padding * 2);
+    popup->open &= matches > 0;
+  }
+  if (mu_begin_window_ex(context, name, mu_rect(0, 0, 0, 0), MU_OPT_POPUP | MU_OPT_NORESIZE | MU_OPT_NOTITLE | MU_OPT_CLOSED))
+  {
+    int clicked = dropdown(context, combo);
+    if (clicked >= 0)
+    {
+      choose(combo, clicked);
+      mu_get_current_container(context)->open = 0;
+      res |= MU_RES_CHANGE;
+    }
+    mu_end_window(context);
+  }
+  else
+  {
+    combo->open = 0;
+  }
+  return res;
+}
@@ -0,0 +1,575 @@
+/**
+ * @file microui_editor.c
+ * @brief Implementation of the gap-buffer text editor
+ *
+ * Offsets in the public state are text offsets, which skip the gap; only
+ * the helpers at the top of this file deal in buffer offsets. Line starts
+ * are kept as text offsets too, so an edit shifts every later entry by the
+ * edit's length in one tight pass rather than re-scanning the text.
+ */
+
+#include <string.h>
+
+#include "microui_editor.h"
+
+/*============================================================================
+** gap buffer
+**============================================================================*/
+
+static int gap_size(mu_Editor *editor)
+{
+  return editor->gap_end - editor->gap_start;
+}
+
+int mu_editor_length(mu_Editor *editor)
+{
+  return editor->capacity - gap_size(editor);
+}
+
+static char char_at(mu_Editor *editor, int pos)
+{
+  return editor->buffer[pos < editor->gap_start ? pos : pos + gap_size(editor)];
+}
+
+static void move_gap(mu_Editor *editor, int pos)
+{
+  char *buffer = editor->buffer;
+  if (pos < editor->gap_start)
+  {
+    int n = editor->gap_start - pos;
+    memmove(buffer + editor->gap_end - n, buffer + pos, n);
+    editor->gap_start -= n;
+    editor->gap_end -= n;
+  }
+  else if (pos > editor->gap_start)
+  {
+    int n = pos - editor->gap_start;
+    memmove(buffer + editor->gap_start, buffer + editor->gap_end, n);
+    editor->gap_start += n;
+    editor->gap_end += n;
+  }
+}
+
+/* split [start, end) into at most two contiguous runs around the gap */
+static int runs(mu_Editor *editor, int start, int end, const char **text, int *length)
+{
+  int n = 0;
+  if (start < editor->gap_start)
+  {
+    text[n] = editor->buffer + start;
+    length[n++] = mu_min(end, editor->gap_start) - start;
+    start = mu_min(end, editor->gap_start);
+  }
+  if (start < end)
+  {
+    text[n] = editor->buffer + start + gap_size(editor);
+    length[n++] = end - start;
+  }
+  return n;
+}
+
+static int measure(mu_Context *context, mu_Editor *editor, int start, int end)
+{
+  const char *text[2];
+  int length[2], i, n = runs(editor, start, end, text, length), width = 0;
+  for (i = 0; i < n; i++)
+  {
+    width += context->text_width(context->style->font, text[i], length[i]);
+  }
+  return width;
+}
+
+static int prev_char(mu_Editor *editor, int pos)
+{
+  /* skip utf-8 continuation bytes */
+  while (pos > 0 && (char_at(editor, --pos) & 0xc0) == 0x80)
+    ;
+  return pos;
+}
+
+static int next_char(mu_Editor *editor, int pos)
+{
+  int length = mu_editor_length(editor);
+  if (pos >= length)
+  {
+    return length;
+  }
+  /* skip utf-8 continuation bytes */
+  while (++pos < length && (char_at(editor, pos) & 0xc0) == 0x80)
+    ;
+  return pos;
+}
+
+/*============================================================================
+** line index
+**============================================================================*/
+
+static int line_of(mu_Editor *editor, int pos)
+{
+  int low = 0, high = editor->line_count;
+  while (high - low > 1)
+  {
+    int mid = (low + high) / 2;
+    if (editor->lines[mid] <= pos)
+    {
+      low = mid;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+static int line_end(mu_Editor *editor, int line)
+{
+  return line + 1 < editor->line_count ? editor->lines[line + 1] - 1 : mu_editor_length(editor);
+}
+
+static int replace(mu_Editor *editor, int start, int end, const char *text, int length)
+{
+  int first = line_of(editor, start), last = line_of(editor, end);
+  int added = 0, removed = last - first, delta = length - (end - start), i, n;
+  for (i = 0; i < length; i++)
+  {
+    added += text[i] == '\n';
+  }
+  if (delta > gap_size(editor) - 1 || editor->line_count - removed + added > editor->line_capacity)
+  {
+    return 0;
+  }
+
+  /* text: the gap absorbs the removed range, then receives the new text */
+  move_gap(editor, end);
+  editor->gap_start = start;
+  memcpy(editor->buffer + start, text, length);
+  editor->gap_start += length;
+
+  /* lines: replace the starts inside (start, end] and shift the rest */
+  n = editor->line_count - last - 1;
+  memmove(editor->lines + first + 1 + added, editor->lines + last + 1, n * sizeof(int));
+  if (editor->states)
+  {
+    /* later lines keep their start state; the changed ones are re-tokenized */
+    memmove(editor->states + first + 1 + added, editor->states + last + 1, n * sizeof(int));
+    if (editor->dirty_last > last)
+    {
+      editor->dirty_last += added - removed;
+    }
+    editor->dirty_last = editor->dirty_first < 0 ? first + added : mu_max(editor->dirty_last, first + added);
+    editor->dirty_first = editor->dirty_first < 0 ? first : mu_min(editor->dirty_first, first);
+  }
+  for (i = first + 1 + added; i < first + 1 + added + n; i++)
+  {
+    editor->lines[i] += delta;
+  }
+  for (i = 0, n = first + 1; i < length; i++)
+  {
+    if (text[i] == '\n')
+    {
+      editor->lines[n++] = start + i + 1;
+    }
+  }
+  editor->line_count += added - removed;
+  editor->version++;
+  return 1;
+}
+
+/*============================================================================
+** editor
+**============================================================================*/
+
+void mu_editor_init(mu_Editor *editor, char *buffer, int capacity, int *lines, int line_capacity)
+{
+  memset(editor, 0, sizeof(*editor));
+  editor->buffer = buffer;
+  editor->capacity = capacity;
+  editor->gap_end = capacity;
+  editor->lines = lines;
+  editor->line_capacity = line_capacity;
+  editor->line_count = 1;
+  editor->preferred_x = -1;
+  editor->cache_line = -1;
+  editor->dirty_first = -1;
+}
+
+int mu_editor_set_text(mu_Editor *editor, const char *text, int length)
+{
+  if (length < 0)
+  {
+    length = strlen(text);
+  }
+  editor->caret = editor->anchor = 0;
+  return replace(editor, 0, mu_editor_length(editor), text, length);
+}
+
+const char *mu_editor_text(mu_Editor *editor)
+{
+  move_gap(editor, mu_editor_length(editor));
+  editor->buffer[editor->gap_start] = '\0';
+  return editor->buffer;
+}
+
+int mu_editor_insert(mu_Editor *editor, const char *text, int length)
+{
+  int start = mu_min(editor->caret, editor->anchor);
+  int end = mu_max(editor->caret, editor->anchor);
+  if (length < 0)
+  {
+    length = strlen(text);
+  }
+  if (!replace(editor, start, end, text, length))
+  {
+    return 0;
+  }
+  editor->caret = editor->anchor = start + length;
+  editor->preferred_x = -1;
+  editor->reveal = 1;
+  return 1;
+}
+
+/* make `cache` hold the prefix widths of `line` */
+static void cache_line(mu_Context *context, mu_Editor *editor, int line)
+{
+  int start = editor->lines[line], i;
+  if (editor->cache_line == line && editor->cache_version == editor->version)
+  {
+    return;
+  }
+  editor->cache_line = line;
+  editor->cache_version = editor->version;
+  editor->cache_count = mu_min(line_end(editor, line) - start, MU_EDITOR_CACHE_SIZE);
+  editor->cache[0] = 0;
+  for (i = 0; i < editor->cache_count;)
+  {
+    int next = mu_min(next_char(editor, start + i) - start, editor->cache_count);
+    int width = editor->cache[i] + measure(context, editor, start + i, start + next);
+    for (i++; i < next; i++)
+    {
+      editor->cache[i] = editor->cache[i - 1];
+    }
+    editor->cache[next] = width;
+    i = next;
+  }
+}
+
+static int x_of(mu_Context *context, mu_Editor *editor, int pos)
+{
+  int line = line_of(editor, pos), column = pos - editor->lines[line];
+  cache_line(context, editor, line);
+  if (column <= editor->cache_count)
+  {
+    return editor->cache[column];
+  }
+  return editor->cache[editor->cache_count] +
+         measure(context, editor, editor->lines[line] + editor->cache_count, pos);
+}
+
+/* text offset on `line` closest to x, searched over the cached prefix widths */
+static int pos_at_x(mu_Context *context, mu_Editor *editor, int line, int x)
+{
+  int start = editor->lines[line], end = line_end(editor, line);
+  int low = 0, high, pos, width;
+  cache_line(context, editor, line);
+  high = editor->cache_count;
+  if (x >= editor->cache[high] && start + high < end)
+  {
+    /* past the cached prefix: walk the rest of a very long line */
+    for (pos = start + high, width = editor->cache[high]; pos < end;)
+    {
+      int next = next_char(editor, pos);
+      int w = measure(context, editor, pos, next);
+      if (x < width + w / 2)
+      {
+        return pos;
+      }
+      width += w;
+      pos = next;
+    }
+    return end;
+  }
+  while (low < high)
+  {
+    int mid = (low + high) / 2;
+    if (editor->cache[mid] + (editor->cache[mid + 1] - editor->cache[mid]) / 2 <= x)
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+  /* never land inside a utf-8 sequence */
+  pos = start + low;
+  while (pos < end && (char_at(editor, pos) & 0xc0) == 0x80)
+  {
+    pos++;
+  }
+  return pos;
+}
+
+static void move_caret(mu_Context *context, mu_Editor *editor, int pos, int keep_x)
+{
+  editor->caret = pos;
+  if (!(context->key_down & MU_KEY_SHIFT))
+  {
+    editor->anchor = pos;
+  }
+  if (!keep_x)
+  {
+    editor->preferred_x = -1;
+  }
+  editor->reveal = 1;
+}
+
+static int handle_keys(mu_Context *context, mu_Editor *editor)
+{
+  int key = context->key_pressed, shift = context->key_down & MU_KEY_SHIFT, res = 0;
+  int start, end, line;
+
+  /* editing */
+  if (context->input_text[0])
+  {
+    res |= mu_editor_insert(editor, context->input_text, -1) ? MU_RES_CHANGE : 0;
+  }
+  if (key & MU_KEY_RETURN)
+  {
+    res |= mu_editor_insert(editor, "\n", 1) ? MU_RES_CHANGE : 0;
+  }
+  start = mu_min(editor->caret, editor->anchor);
+  end = mu_max(editor->caret, editor->anchor);
+  if (key & (MU_KEY_BACKSPACE | MU_KEY_DELETE))
+  {
+    if (start == end)
+    {
+      start = key & MU_KEY_BACKSPACE ? prev_char(editor, start) : start;
+      end = key & MU_KEY_DELETE ? next_char(editor, end) : end;
+    }
+    if (start < end && replace(editor, start, end, "", 0))
+    {
+      move_caret(context, editor, start, 0);
+      editor->anchor = start;
+      res |= MU_RES_CHANGE;
+    }
+  }
+
+  /* navigation: without shift, left and right collapse a selection */
+  start = mu_min(editor->caret, editor->anchor);
+  end = mu_max(editor->caret, editor->anchor);
+  line = line_of(editor, editor->caret);
+  if (key & MU_KEY_LEFT)
+  {
+    move_caret(context, editor, start < end && !shift ? start : prev_char(editor, editor->caret), 0);
+  }
+  if (key & MU_KEY_RIGHT)
+  {
+    move_caret(context, editor, start < end && !shift ? end : next_char(editor, editor->caret), 0);
+  }
+  if (key & MU_KEY_HOME)
+  {
+    move_caret(context, editor, editor->lines[line], 0);
+  }
+  if (key & MU_KEY_END)
+  {
+    move_caret(context, editor, line_end(editor, line), 0);
+  }
+  if (key & (MU_KEY_UP | MU_KEY_DOWN))
+  {
+    int target = line + (key & MU_KEY_DOWN ? 1 : -1);
+    if (editor->preferred_x < 0)
+    {
+      editor->preferred_x = x_of(context, editor, editor->caret);
+    }
+    if (target >= 0 && target < editor->line_count)
+    {
+      move_caret(context, editor, pos_at_x(context, editor, target, editor->preferred_x), 1);
+    }
+  }
+  return res;
+}
+
+/*============================================================================
+** tokenizer
+**============================================================================*/
+
+void mu_editor_set_tokenizer(mu_Editor *editor, mu_Tokenizer tokenize, void *user, int *states)
+{
+  editor->tokenize = tokenize;
+  editor->tokenize_user = user;
+  editor->states = tokenize ? states : NULL;
+  if (editor->states)
+  {
+    editor->states[0] = 0;
+    editor->dirty_first = 0;
+    editor->dirty_last = editor->line_count - 1;
+  }
+}
+
+/* a line as one contiguous run. a line split by the gap is joined in the
+** scratch copy so the gap stays at the caret; only a line too long for the
+** copy moves the gap out of the way */
+static const char *line_text(mu_Editor *editor, int line, int *length)
+{
+  int start = editor->lines[line], end = line_end(editor, line);
+  *length = end - start;
+  if (editor->gap_start > start && editor->gap_start < end)
+  {
+    const char *parts[2];
+    int lengths[2], n, i, offset = 0;
+    if (*length > MU_EDITOR_LINE_SIZE)
+    {
+      move_gap(editor, end);
+      return editor->buffer + start;
+    }
+    n = runs(editor, start, end, parts, lengths);
+    for (i = 0; i < n; i++)
+    {
+      memcpy(editor->line + offset, parts[i], lengths[i]);
+      offset += lengths[i];
+    }
+    return editor->line;
+  }
+  return editor->buffer + (start < editor->gap_start ? start : start + gap_size(editor));
+}
+
+/* re-tokenize stale lines up to `line`, stopping early once a line ends in
+** the state the next line already starts with */
+static void update_states(mu_Editor *editor, int line)
+{
+  mu_TextRun spans[MU_EDITOR_MAX_RUNS];
+  while (editor->dirty_first >= 0 && editor->dirty_first <= line)
+  {
+    int i = editor->dirty_first, length, count;
+    const char *text = line_text(editor, i, &length);
+    int state = editor->tokenize(editor->tokenize_user, editor->states[i], text, length, spans, &count);
+    if (i + 1 >= editor->line_count || (i + 1 > editor->dirty_last && editor->states[i + 1] == state))
+    {
+      editor->dirty_first = -1;
+      break;
+    }
+    editor->states[i + 1] = state;
+    editor->dirty_first = i + 1;
+  }
+}
+
+static void draw_line(mu_Context *context, mu_Editor *editor, int line, mu_Vector2 position, mu_Color color)
+{
+  mu_Font font = context->style->font;
+  mu_TextRun spans[MU_EDITOR_MAX_RUNS];
+  const char *text;
+  int length, count, offset = 0, i;
+  if (!editor->tokenize)
+  {
+    const char *parts[2];
+    int lengths[2], n = runs(editor, editor->lines[line], line_end(editor, line), parts, lengths);
+    for (i = 0; i < n; i++)
+    {
+      mu_draw_text(context, font, parts[i], lengths[i], position, color);
+      position.x += context->text_width(font, parts[i], lengths[i]);
+    }
+    return;
+  }
+
+  /* one text command per run, plus one for each uncolored stretch */
+  update_states(editor, line);
+  text = line_text(editor, line, &length);
+  editor->tokenize(editor->tokenize_user, editor->states[line], text, length, spans, &count);
+  count = mu_clamp(count, 0, MU_EDITOR_MAX_RUNS);
+  for (i = 0; i <= count; i++)
+  {
+    int start = i < count ? mu_clamp(spans[i].offset, offset, length) : length;
+    int end = i < count ? mu_clamp(spans[i].offset + spans[i].length, start, length) : length;
+    if (start > offset)
+    {
+      mu_draw_text(context, font, text + offset, start - offset, position, color);
+      position.x += context->text_width(font, text + offset, start - offset);
+    }
+    if (end > start)
+    {
+      mu_draw_text(context, font, text + start, end - start, position, spans[i].color);
+      position.x += context->text_width(font, text + start, end - start);
+    }
+    offset = end;
+  }
+}
+
+int mu_editor_ex(mu_Context *context, mu_Editor *editor, int opt)
+{
+  mu_Style *style = context->style;
+  mu_Container *container = mu_get_current_container(context);
+  mu_Identifier identifier = mu_get_id(context, &editor, sizeof(editor));
+  int line_height = context->text_height(style->font);
+  int width = mu_max(container->body.w - style->padding * 2, editor->max_width + style->padding * 2);
+  int res = 0, first, last, line, start, end;
+  mu_Rectangle area;
+  mu_Color color = style->colors[MU_COLOR_TEXT];
+
+  area = mu_layout_rows_ex(context, editor->line_count, line_height, width, style->padding, &first, &last);
+  mu_update_control(context, identifier, area, opt | MU_OPT_HOLDFOCUS);
+
+  if (context->focus == identifier)
+  {
+    res |= MU_RES_ACTIVE;
+
+    /* mouse: click places the caret (shift extends), drag selects */
+    if (context->mouse_down & MU_MOUSE_LEFT)
+    {
+      int x = context->mouse_pos.x - area.x - style->padding;
+      line = mu_clamp((context->mouse_pos.y - area.y - style->padding) / line_height, 0,
+                      editor->line_count - 1);
+      editor->caret = pos_at_x(context, editor, line, x);
+      if (context->mouse_pressed & MU_MOUSE_LEFT && !(context->key_down & MU_KEY_SHIFT))
+      {
+        editor->anchor = editor->caret;
+      }
+      editor->preferred_x = -1;
+    }
+    res |= handle_keys(context, editor);
+  }
+
+  /* scroll the caret into view; the layout above already used this
+  ** frame's scroll, so the move shows on the next frame */
+  if (editor->reveal)
+  {
+    int y = area.y - container->body.y + container->scroll.y + style->padding +
+            line_of(editor, editor->caret) * line_height;
+    int x = area.x - container->body.x + container->scroll.x + style->padding +
+            x_of(context, editor, editor->caret);
+    container->scroll.y = mu_clamp(container->scroll.y, y + line_height - container->body.h, y);
+    container->scroll.x = mu_clamp(container->scroll.x, x + 1 - container->body.w, x);
+    editor->reveal = 0;
+  }
+
+  /* draw visible lines, their selection, and the caret */
+  mu_draw_control_frame(context, identifier, area, MU_COLOR_BASE, opt);
+  start = mu_min(editor->caret, editor->anchor);
+  end = mu_max(editor->caret, editor->anchor);
+  mu_push_clip_rect(context, area);
+  for (line = first; line < last; line++)
+  {
+    mu_Vector2 position = mu_vec2(area.x + style->padding, area.y + style->padding + line * line_height);
+    int line_start = editor->lines[line], line_stop = line_end(editor, line);
+    if (start < end && start <= line_stop && end > line_start)
+    {
+      int x1 = measure(context, editor, line_start, mu_max(start, line_start));
+      int x2 = end > line_stop ? measure(context, editor, line_start, line_stop) + style->padding
+                               : measure(context, editor, line_start, end);
+      mu_draw_rect(context, mu_rect(position.x + x1, position.y, x2 - x1, line_height),
+                   style->colors[MU_COLOR_BUTTONHOVER]);
+    }
+    editor->max_width = mu_max(editor->max_width, measure(context, editor, line_start, line_stop));
+    draw_line(context, editor, line, position, color);
+  }
+  if (context->focus == identifier)
+  {
+    line = line_of(editor, editor->caret);
+    mu_draw_rect(context, mu_rect(area.x + style->padding + x_of(context, editor, editor->caret),
+                                  area.y + style->padding + line * line_height, 1, line_height),
+                 color);
+  }
+  mu_pop_clip_rect(context);
+
+  return res;
+}
@@ -0,0 +1,301 @@
+/**
+ * @file microui_histogram.c
+ * @brief Implementation of the streaming histogram
+ *
+ * Binning maps each sample to a slot: 0 for underflow, 1..bins for the
+ * bins and bins + 1 for overflow. Slot indices are computed four at a time
+ * where SSE2 or NEON is available, and counted into a small integer table
+ * per batch before being added to the retained counts. Log scales use a
+ * polynomial log2 built from the float's exponent and mantissa, shared by
+ * the vector and scalar paths so both put a sample in the same bin.
+ */
+
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MU_HISTOGRAM_SSE
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MU_HISTOGRAM_NEON
+#endif
+
+#include "microui_histogram.h"
+
+/* samples per batch, small enough for 32-bit slot counts */
+#define BATCH_SIZE (1 << 20)
+
+/* log2(1 + t) ~ t + t (t - 1) (C0 + t (C1 + t C2)) for t in [0, 1), exact at
+** both ends so octaves join up; max error about 1.2e-4 */
+#define LOG2_C0 -0.43872437f
+#define LOG2_C1 0.23905283f
+#define LOG2_C2 -0.08212626f
+
+/*============================================================================
+** scale
+**============================================================================*/
+
+static float fast_log2(float x)
+{
+  unsigned bits;
+  float t;
+  int e;
+  memcpy(&bits, &x, sizeof(bits));
+  e = (int)((bits >> 23) & 0xff) - 127;
+  bits = (bits & 0x7fffff) | 0x3f800000;
+  memcpy(&t, &bits, sizeof(t));
+  t -= 1;
+  return e + (t + t * (t - 1) * (LOG2_C0 + t * (LOG2_C1 + t * LOG2_C2)));
+}
+
+static float to_scale(const mu_Histogram *histogram, float x)
+{
+  return histogram->opt & MU_HISTOGRAM_LOG ? fast_log2(x) : x;
+}
+
+/*============================================================================
+** binning
+**============================================================================*/
+
+static void count_slots(const mu_Histogram *histogram, const float *p, int n, unsigned *slots)
+{
+  int log = histogram->opt & MU_HISTOGRAM_LOG, i = 0;
+  float low = to_scale(histogram, histogram->low);
+  float scale = histogram->bins / (to_scale(histogram, histogram->high) - low);
+  float top = (float)(histogram->bins + 1);
+#if defined(MU_HISTOGRAM_SSE)
+  {
+    __m128 vlow = _mm_set1_ps(low), vscale = _mm_set1_ps(scale), vtop = _mm_set1_ps(top);
+    __m128 one = _mm_set1_ps(1), zero = _mm_setzero_ps();
+    __m128 c0 = _mm_set1_ps(LOG2_C0), c1 = _mm_set1_ps(LOG2_C1), c2 = _mm_set1_ps(LOG2_C2);
+    __m128i mantissa = _mm_set1_epi32(0x7fffff), exponent = _mm_set1_epi32(0x3f800000);
+    __m128i bias = _mm_set1_epi32(127);
+    int out[4];
+    for (; i + 4 <= n; i += 4)
+    {
+      __m128 x = _mm_loadu_ps(p + i), s = x, u;
+      if (log)
+      {
+        __m128i bits = _mm_castps_si128(x);
+        __m128 e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), bias));
+        __m128 t = _mm_sub_ps(_mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, mantissa), exponent)), one);
+        __m128 poly = _mm_add_ps(c0, _mm_mul_ps(t, _mm_add_ps(c1, _mm_mul_ps(t, c2))));
+        poly = _mm_mul_ps(_mm_mul_ps(t, _mm_sub_ps(t, one)), poly);
+        s = _mm_add_ps(e, _mm_add_ps(t, poly));
+      }
+      u = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(s, vlow), vscale), one);
+      /* max returns its second operand for NaN, sending it to underflow */
+      u = _mm_min_ps(_mm_max_ps(u, zero), vtop);
+      if (log)
+      {
+        u = _mm_and_ps(u, _mm_cmpgt_ps(x, zero));
+      }
+      _mm_storeu_si128((__m128i *)out, _mm_cvttps_epi32(u));
+      slots[out[0]]++;
+      slots[out[1]]++;
+      slots[out[2]]++;
+      slots[out[3]]++;
+    }
+  }
+#elif defined(MU_HISTOGRAM_NEON)
+  {
+    float32x4_t vlow = vdupq_n_f32(low), vscale = vdupq_n_f32(scale), vtop = vdupq_n_f32(top);
+    float32x4_t one = vdupq_n_f32(1), zero = vdupq_n_f32(0);
+    int32_t out[4];
+    for (; i + 4 <= n; i += 4)
+    {
+      float32x4_t x = vld1q_f32(p + i), s = x, u;
+      uint32x4_t valid;
+      if (log)
+      {
+        uint32x4_t bits = vreinterpretq_u32_f32(x);
+        float32x4_t e = vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), vdupq_n_s32(127)));
+        float32x4_t t = vsubq_f32(
+            vreinterpretq_f32_u32(vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x7fffff)), vdupq_n_u32(0x3f800000))), one);
+        float32x4_t poly = vmlaq_f32(vdupq_n_f32(LOG2_C1), t, vdupq_n_f32(LOG2_C2));
+        poly = vmlaq_f32(vdupq_n_f32(LOG2_C0), t, poly);
+        poly = vmulq_f32(vmulq_f32(t, vsubq_f32(t, one)), poly);
+        s = vaddq_f32(e, vaddq_f32(t, poly));
+      }
+      u = vmlaq_f32(one, vsubq_f32(s, vlow), vscale);
+      /* comparisons are false for NaN, sending it to underflow */
+      valid = vcgeq_f32(u, zero);
+      if (log)
+      {
+        valid = vandq_u32(valid, vcgtq_f32(x, zero));
+      }
+      u = vbslq_f32(valid, vminq_f32(u, vtop), zero);
+      vst1q_s32(out, vcvtq_s32_f32(u));
+      slots[out[0]]++;
+      slots[out[1]]++;
+      slots[out[2]]++;
+      slots[out[3]]++;
+    }
+  }
+#endif
+  for (; i < n; i++)
+  {
+    float u = (to_scale(histogram, p[i]) - low) * scale + 1;
+    if (!(u >= 0) || (log && !(p[i] > 0)))
+    {
+      u = 0;
+    }
+    slots[(int)mu_min(u, top)]++;
+  }
+}
+
+/* range of the samples that fit the scale, for MU_HISTOGRAM_AUTORANGE */
+static void span_range(const float *p, int n, int positive, float *lo, float *hi)
+{
+  for (int i = 0; i < n; i++)
+  {
+    /* NaN fails both comparisons */
+    if (p[i] > 0 || (!positive && p[i] <= 0))
+    {
+      *lo = mu_min(*lo, p[i]);
+      *hi = mu_max(*hi, p[i]);
+    }
+  }
+}
+
+static void widen(mu_Histogram *histogram, const float *p, int n)
+{
+  int log = histogram->opt & MU_HISTOGRAM_LOG;
+  float lo = histogram->high, hi = histogram->low, span = histogram->high - histogram->low;
+  float low = histogram->low, high = histogram->high;
+  span_range(p, n, log, &lo, &hi);
+  /* overshoot so a slowly drifting stream does not re-bin every batch */
+  if (lo < histogram->low)
+  {
+    low = log ? lo * 0.5f : lo - span * 0.25f;
+  }
+  if (hi >= histogram->high)
+  {
+    high = log ? hi * 2 : hi + span * 0.25f;
+  }
+  if (low != histogram->low || high != histogram->high)
+  {
+    mu_histogram_set_range(histogram, low, high);
+  }
+}
+
+/*============================================================================
+** histogram
+**============================================================================*/
+
+void mu_histogram_init(mu_Histogram *histogram, float low, float high, int bins, int opt)
+{
+  memset(histogram, 0, sizeof(*histogram));
+  histogram->low = low;
+  histogram->high = high > low ? high : low + 1;
+  histogram->bins = mu_clamp(bins, 1, MU_HISTOGRAM_MAX_BINS);
+  histogram->opt = opt;
+}
+
+void mu_histogram_clear(mu_Histogram *histogram)
+{
+  memset(histogram->counts, 0, sizeof(histogram->counts));
+  histogram->underflow = histogram->overflow = histogram->total = 0;
+  histogram->version++;
+}
+
+void mu_histogram_set_range(mu_Histogram *histogram, float low, float high)
+{
+  double counts[MU_HISTOGRAM_MAX_BINS] = {0};
+  int bins = histogram->bins, i, j;
+  float old_low = to_scale(histogram, histogram->low), new_low, width;
+  float old_width = (to_scale(histogram, histogram->high) - old_low) / bins;
+  if (high <= low || (low == histogram->low && high == histogram->high))
+  {
+    return;
+  }
+  new_low = to_scale(histogram, low);
+  width = (to_scale(histogram, high) - new_low) / bins;
+
+  /* spread each old bin evenly over the new bins it overlaps */
+  for (i = 0; i < bins; i++)
+  {
+    double count = histogram->counts[i];
+    double a = (old_low + i * old_width - new_low) / width, b = a + old_width / width;
+    if (count == 0)
+    {
+      continue;
+    }
+    if (a < 0)
+    {
+      histogram->underflow += count * (mu_min(b, 0) - a) / (b - a);
+    }
+    if (b > bins)
+    {
+      histogram->overflow += count * (b - mu_max(a, bins)) / (b - a);
+    }
+    for (j = mu_max((int)a, 0); j < bins && j < b; j++)
+    {
+      double overlap = mu_min(b, j + 1) - mu_max(a, j);
+      if (overlap > 0)
+      {
+        counts[j] += count * overlap / (b - a);
+      }
+    }
+  }
+  memcpy(histogram->counts, counts, sizeof(counts));
+  histogram->low = low;
+  histogram->high = high;
+  histogram->version++;
+}
+
+void mu_histogram_push(mu_Histogram *histogram, const float *values, int count)
+{
+  unsigned slots[MU_HISTOGRAM_MAX_BINS + 2];
+  while (count > 0)
+  {
+    int n = mu_min(count, BATCH_SIZE), i;
+    if (histogram->opt & MU_HISTOGRAM_AUTORANGE)
+    {
+      widen(histogram, values, n);
+    }
+    memset(slots, 0, sizeof(slots));
+    count_slots(histogram, values, n, slots);
+    histogram->underflow += slots[0];
+    for (i = 0; i < histogram->bins; i++)
+    {
+      histogram->counts[i] += slots[i + 1];
+    }
+    histogram->overflow += slots[histogram->bins + 1];
+    histogram->total += n;
+    values += n;
+    count -= n;
+  }
+  histogram->version++;
+}
+
+void mu_histogram_ex(mu_Context *context, const mu_Histogram *histogram, mu_Color color, int opt)
+{
+  mu_Rectangle base = mu_layout_next(context);
+  double peak = 0;
+  int i;
+  if (~opt & MU_OPT_NOFRAME)
+  {
+    context->draw_frame(context, base, MU_COLOR_BASE);
+  }
+  for (i = 0; i < histogram->bins; i++)
+  {
+    peak = mu_max(peak, histogram->counts[i]);
+  }
+  if (peak <= 0 || base.w <= 0 || base.h <= 0)
+  {
+    return;
+  }
+
+  /* one bar per non-empty bin; bins narrower than a pixel share columns */
+  for (i = 0; i < histogram->bins; i++)
+  {
+    int x1 = base.x + i * base.w / histogram->bins;
+    int x2 = base.x + (i + 1) * base.w / histogram->bins;
+    int h = (int)(histogram->counts[i] / peak * base.h + 0.5);
+    if (h > 0)
+    {
+      mu_draw_rect(context, mu_rect(x1, base.y + base.h - h, mu_max(x2 - x1 - 1, 1), h), color);
+    }
+  }
+}
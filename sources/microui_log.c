@@ -0,0 +1,327 @@
+/**
+ * @file microui_log.c
+ * @brief Implementation of the ring-buffered log view
+ *
+ * Live text always occupies one circular run of the ring, from the oldest
+ * line's offset up to the write offset. A line never wraps around the end
+ * of the ring: if it does not fit in the tail it is written at offset 0 and
+ * the tail is left unused until the run catches up with it.
+ *
+ * Searching leans on memchr, which the C library vectorizes, to skip to
+ * candidate positions, and only compares the full pattern there.
+ */
+
+#include <string.h>
+
+#include "microui_log.h"
+
+void mu_log_init(mu_Log *log, char *text, int text_capacity, mu_LogLine *lines, int line_capacity)
+{
+  memset(log, 0, sizeof(*log));
+  log->text = text;
+  log->text_capacity = text_capacity;
+  log->lines = lines;
+  log->line_capacity = line_capacity;
+}
+
+void mu_log_clear(mu_Log *log)
+{
+  log->write = 0;
+  log->first = 0;
+  log->count = 0;
+}
+
+static mu_LogLine *oldest(mu_Log *log)
+{
+  return &log->lines[log->first];
+}
+
+static void evict(mu_Log *log)
+{
+  log->first = (log->first + 1) % log->line_capacity;
+  log->count--;
+}
+
+static void push_line(mu_Log *log, const char *text, int length)
+{
+  mu_LogLine *line;
+  length = mu_min(length, log->text_capacity);
+
+  /* free a contiguous run of `length` bytes at the write offset */
+  if (log->write + length > log->text_capacity)
+  {
+    while (log->count && oldest(log)->offset >= log->write)
+    {
+      evict(log);
+    }
+    log->write = 0;
+  }
+  while (log->count && oldest(log)->offset >= log->write &&
+         oldest(log)->offset < log->write + length)
+  {
+    evict(log);
+  }
+  if (log->count == log->line_capacity)
+  {
+    evict(log);
+  }
+
+  line = &log->lines[(log->first + log->count) % log->line_capacity];
+  line->offset = log->write;
+  line->length = length;
+  memcpy(log->text + log->write, text, length);
+  log->write += length;
+  log->count++;
+  log->total++;
+}
+
+void mu_log_append(mu_Log *log, const char *text, int length)
+{
+  const char *end;
+  if (length < 0)
+  {
+    length = strlen(text);
+  }
+  end = text + length;
+  for (;;)
+  {
+    const char *newline = memchr(text, '\n', end - text);
+    if (!newline)
+    {
+      push_line(log, text, end - text);
+      return;
+    }
+    push_line(log, text, newline - text);
+    text = newline + 1;
+  }
+}
+
+const char *mu_log_line(mu_Log *log, int idx, int *length)
+{
+  mu_LogLine *line = &log->lines[(log->first + idx) % log->line_capacity];
+  *length = line->length;
+  return log->text + line->offset;
+}
+
+/*============================================================================
+** search
+**============================================================================*/
+
+static const char *find(const char *text, int length, const char *pattern, int pattern_length)
+{
+  const char *end = text + length - pattern_length + 1;
+  while (text < end)
+  {
+    text = memchr(text, pattern[0], end - text);
+    if (!text)
+    {
+      return NULL;
+    }
+    if (memcmp(text + 1, pattern + 1, pattern_length - 1) == 0)
+    {
+      return text;
+    }
+    text++;
+  }
+  return NULL;
+}
+
+static unsigned long long match_at(mu_LogSearch *search, int idx)
+{
+  return search->matches[(search->match_first + idx) % search->match_capacity];
+}
+
+/* index of the first match on or after `line` */
+static int lower_bound(mu_LogSearch *search, unsigned long long line)
+{
+  int low = 0, high = search->match_count;
+  while (low < high)
+  {
+    int mid = (low + high) / 2;
+    if (match_at(search, mid) < line)
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+/* forget matches and progress on lines the ring has evicted */
+static void prune(mu_Log *log, mu_LogSearch *search)
+{
+  unsigned long long base = log->total - log->count;
+  while (search->match_count && match_at(search, 0) < base)
+  {
+    search->match_first = (search->match_first + 1) % search->match_capacity;
+    search->match_count--;
+  }
+  if (search->scanned < base)
+  {
+    search->scanned = base;
+  }
+  if (search->current >= 0 && (unsigned long long)search->current < base)
+  {
+    search->current = -1;
+  }
+}
+
+void mu_log_search_init(mu_Log *log, mu_LogSearch *search, unsigned long long *matches, int match_capacity)
+{
+  memset(search, 0, sizeof(*search));
+  search->matches = matches;
+  search->match_capacity = match_capacity;
+  search->current = -1;
+  log->search = search;
+}
+
+void mu_log_search_set(mu_LogSearch *search, const char *pattern)
+{
+  search->length = mu_min((int)strlen(pattern), MU_LOG_PATTERN_SIZE - 1);
+  memcpy(search->pattern, pattern, search->length);
+  search->pattern[search->length] = '\0';
+  search->match_first = search->match_count = 0;
+  search->scanned = 0;
+  search->current = -1;
+  search->jump = 0;
+}
+
+int mu_log_search_step(mu_Log *log, int budget)
+{
+  mu_LogSearch *search = log->search;
+  unsigned long long base = log->total - log->count;
+  if (!search || search->length == 0)
+  {
+    return 1;
+  }
+  prune(log, search);
+  while (search->scanned < log->total && budget > 0)
+  {
+    int length;
+    const char *text = mu_log_line(log, (int)(search->scanned - base), &length);
+    if (find(text, length, search->pattern, search->length))
+    {
+      if (search->match_count == search->match_capacity)
+      {
+        search->match_first = (search->match_first + 1) % search->match_capacity;
+        search->match_count--;
+      }
+      search->matches[(search->match_first + search->match_count++) % search->match_capacity] =
+          search->scanned;
+    }
+    budget -= length + 1;
+    search->scanned++;
+  }
+  return search->scanned == log->total;
+}
+
+int mu_log_search_next(mu_Log *log, int direction)
+{
+  mu_LogSearch *search = log->search;
+  int idx;
+  if (!search)
+  {
+    return 0;
+  }
+  prune(log, search);
+  if (search->current < 0)
+  {
+    idx = direction > 0 ? 0 : search->match_count - 1;
+  }
+  else if (direction > 0)
+  {
+    idx = lower_bound(search, search->current + 1);
+  }
+  else
+  {
+    idx = lower_bound(search, search->current) - 1;
+  }
+  if (idx < 0 || idx >= search->match_count)
+  {
+    return 0;
+  }
+  search->current = match_at(search, idx);
+  search->jump = 1;
+  return 1;
+}
+
+/*============================================================================
+** widget
+**============================================================================*/
+
+static void draw_matches(mu_Context *context, mu_Log *log, mu_Rectangle area, int first, int last)
+{
+  mu_LogSearch *search = log->search;
+  mu_Style *style = context->style;
+  int line_height = context->text_height(style->font);
+  unsigned long long base = log->total - log->count;
+  int i;
+  for (i = lower_bound(search, base + first);
+       i < search->match_count && match_at(search, i) < base + last; i++)
+  {
+    unsigned long long line = match_at(search, i);
+    int colorid = (long long)line == search->current ? MU_COLOR_BUTTONFOCUS : MU_COLOR_BUTTONHOVER;
+    int length, y = area.y + (int)(line - base) * line_height;
+    const char *text = mu_log_line(log, (int)(line - base), &length);
+    const char *hit = text;
+    while ((hit = find(hit, length - (hit - text), search->pattern, search->length)))
+    {
+      int x = area.x + context->text_width(style->font, text, hit - text);
+      int w = context->text_width(style->font, hit, search->length);
+      mu_draw_rect(context, mu_rect(x, y, w, line_height), style->colors[colorid]);
+      hit += search->length;
+    }
+  }
+}
+
+void mu_log(mu_Context *context, mu_Log *log)
+{
+  mu_Style *style = context->style;
+  mu_Container *container = mu_get_current_container(context);
+  int line_height = context->text_height(style->font);
+  int first, last, i;
+  mu_Rectangle area;
+
+  /* keep following new lines while scrolled to the bottom; the previous
+  ** frame's content size is what the current scroll offset was clamped to */
+  if (log->shown != log->total)
+  {
+    int bottom = container->content_size.y + style->padding * 2 - container->body.h;
+    if (container->scroll.y >= bottom - line_height)
+    {
+      container->scroll.y = log->count * line_height + style->padding * 2;
+    }
+    log->shown = log->total;
+  }
+
+  /* advance the search and bring a newly selected hit into view */
+  if (log->search && log->search->length)
+  {
+    mu_LogSearch *search = log->search;
+    mu_log_search_step(log, MU_LOG_SEARCH_BUDGET);
+    if (search->jump && search->current >= 0)
+    {
+      int row = (int)(search->current - (log->total - log->count));
+      container->scroll.y = mu_max(0, row * line_height - (container->body.h - line_height) / 2);
+    }
+    search->jump = 0;
+  }
+
+  area = mu_layout_rows(context, log->count, line_height, &first, &last);
+
+  if (log->search && log->search->length)
+  {
+    draw_matches(context, log, area, first, last);
+  }
+
+  for (i = first; i < last; i++)
+  {
+    int length;
+    const char *text = mu_log_line(log, i, &length);
+    mu_draw_text(context, style->font, text, length,
+                 mu_vec2(area.x, area.y + i * line_height), style->colors[MU_COLOR_TEXT]);
+  }
+}
@@ -0,0 +1,120 @@
+/**
+ * @file microui_sparkline.c
+ * @brief Implementation of the batched sparklines
+ *
+ * The polylines command needs every line to have the same number of
+ * points, so a sparkline with fewer samples than columns repeats its last
+ * point; the extra segments have no length and draw nothing.
+ */
+
+#include "microui_sparkline.h"
+
+/*============================================================================
+** decimation
+**============================================================================*/
+
+static void value_range(const float *values, int count, float *low, float *high)
+{
+  float lo = values[0], hi = values[0];
+  for (int i = 1; i < count; i++)
+  {
+    lo = mu_min(lo, values[i]);
+    hi = mu_max(hi, values[i]);
+  }
+  *low = lo;
+  *high = hi;
+}
+
+/* bucket i's minimum or maximum, whichever is further from `previous` */
+static float bucket_value(const float *values, int start, int end, float previous)
+{
+  float lo, hi;
+  value_range(values + start, end - start, &lo, &hi);
+  return hi - previous > previous - lo ? hi : lo;
+}
+
+static int to_y(mu_Rectangle base, float value, float low, float high)
+{
+  float t = (value - low) / (high - low);
+  /* NaN fails the comparison and sits on the baseline */
+  t = t > 0 ? mu_min(t, 1) : 0;
+  return base.y + base.h - 1 - (int)(t * (base.h - 1) + 0.5f);
+}
+
+/*============================================================================
+** batch
+**============================================================================*/
+
+static void flush(mu_Context *context, mu_Sparklines *batch)
+{
+  mu_draw_polylines(context, batch->points, batch->count, batch->columns, batch->color);
+  batch->count = 0;
+}
+
+void mu_sparklines_begin(mu_Context *context, mu_Sparklines *batch, mu_Vector2 *points, int capacity,
+                         int columns, mu_Color color)
+{
+  (void)context;
+  batch->points = points;
+  batch->capacity = capacity;
+  batch->count = 0;
+  batch->columns = mu_clamp(columns, 2, capacity);
+  batch->color = color;
+}
+
+void mu_sparkline_ex(mu_Context *context, mu_Sparklines *batch, const float *values, int count, float low,
+                     float high, int opt)
+{
+  mu_Rectangle base = mu_layout_next(context);
+  int columns = batch->columns, used, i;
+  mu_Vector2 *points;
+  float previous;
+
+  /* rows scrolled out of view cost one clip test */
+  if (mu_check_clip(context, base) == MU_CLIP_ALL)
+  {
+    return;
+  }
+  if (~opt & MU_OPT_NOFRAME)
+  {
+    context->draw_frame(context, base, MU_COLOR_BASE);
+  }
+  if (count < 1 || base.w < 2 || base.h < 1 || batch->capacity < columns)
+  {
+    return;
+  }
+  if (!(high > low))
+  {
+    value_range(values, count, &low, &high);
+    if (!(high > low))
+    {
+      low -= 1;
+      high += 1;
+    }
+  }
+  if (batch->count + columns > batch->capacity)
+  {
+    flush(context, batch);
+  }
+
+  points = batch->points + batch->count;
+  used = mu_min(count, columns);
+  previous = values[0];
+  for (i = 0; i < used; i++)
+  {
+    int start = (int)((long long)i * count / used), end = (int)((long long)(i + 1) * count / used);
+    previous = bucket_value(values, start, end, previous);
+    points[i].x = base.x + (used > 1 ? i * (base.w - 1) / (used - 1) : 0);
+    points[i].y = to_y(base, previous, low, high);
+  }
+  for (; i < columns; i++)
+  {
+    points[i] = points[used - 1];
+  }
+  batch->count += columns;
+}
+
+void mu_sparklines_end(mu_Context *context, mu_Sparklines *batch)
+{
+  flush(context, batch);
+}
@@ -0,0 +1,266 @@
+/**
+ * @file microui_table.c
+ * @brief Implementation of the virtualized table
+ *
+ * Sorting is an in-place heapsort of the permutation, so it needs no scratch
+ * memory and stays O(n log n) however the compare callback behaves.
+ */
+
+#include <string.h>
+
+#include "microui_table.h"
+
+/*============================================================================
+** sorting
+**============================================================================*/
+
+static int compare_rows(mu_Table *table, int a, int b)
+{
+  mu_TableSource *src = &table->source;
+  int order = src->compare(src->user, table->sort_column, a, b);
+  return table->sort_descending ? -order : order;
+}
+
+static void sift_down(mu_Table *table, int root, int end)
+{
+  int *order = table->order;
+  for (;;)
+  {
+    int child = root * 2 + 1, tmp;
+    if (child >= end)
+    {
+      return;
+    }
+    if (child + 1 < end && compare_rows(table, order[child], order[child + 1]) < 0)
+    {
+      child++;
+    }
+    if (compare_rows(table, order[root], order[child]) >= 0)
+    {
+      return;
+    }
+    tmp = order[root];
+    order[root] = order[child];
+    order[child] = tmp;
+    root = child;
+  }
+}
+
+void mu_table_sort(mu_Table *table, int column, int descending)
+{
+  int i, n = table->row_count;
+  if (!table->order || !table->source.compare || column < 0 || column >= table->column_count)
+  {
+    return;
+  }
+  table->sort_column = column;
+  table->sort_descending = descending;
+  for (i = n / 2 - 1; i >= 0; i--)
+  {
+    sift_down(table, i, n);
+  }
+  for (i = n - 1; i > 0; i--)
+  {
+    int tmp = table->order[0];
+    table->order[0] = table->order[i];
+    table->order[i] = tmp;
+    sift_down(table, 0, i);
+  }
+}
+
+/*============================================================================
+** table
+**============================================================================*/
+
+void mu_table_init(mu_Table *table, mu_TableSource source, int row_count, int *order)
+{
+  memset(table, 0, sizeof(*table));
+  table->source = source;
+  table->order = order;
+  table->sort_column = -1;
+  table->selected = -1;
+  mu_table_set_rows(table, row_count);
+}
+
+void mu_table_add_column(mu_Table *table, const char *title, int width)
+{
+  mu_TableColumn *column;
+  if (table->column_count >= MU_TABLE_MAX_COLUMNS)
+  {
+    return;
+  }
+  column = &table->columns[table->column_count++];
+  column->title = title;
+  column->width = width;
+  column->measured = 0;
+}
+
+void mu_table_set_rows(mu_Table *table, int row_count)
+{
+  int i;
+  table->row_count = row_count;
+  table->measured_first = table->measured_last = 0;
+  if (table->selected >= row_count)
+  {
+    table->selected = -1;
+  }
+  if (!table->order)
+  {
+    return;
+  }
+  for (i = 0; i < row_count; i++)
+  {
+    table->order[i] = i;
+  }
+  if (table->sort_column >= 0)
+  {
+    mu_table_sort(table, table->sort_column, table->sort_descending);
+  }
+}
+
+static int data_row(mu_Table *table, int row)
+{
+  return table->order ? table->order[row] : row;
+}
+
+/* grow the cached widths of auto-sized columns to fit rows [first, last) */
+static void measure_columns(mu_Context *context, mu_Table *table, int first, int last)
+{
+  mu_TableSource *src = &table->source;
+  mu_Font font = context->style->font;
+  int padding = context->style->padding * 2;
+  char buffer[MU_TABLE_CELL_SIZE];
+  int c, r;
+  if (first == table->measured_first && last == table->measured_last)
+  {
+    return;
+  }
+  table->measured_first = first;
+  table->measured_last = last;
+  for (c = 0; c < table->column_count; c++)
+  {
+    mu_TableColumn *column = &table->columns[c];
+    if (column->width > 0)
+    {
+      continue;
+    }
+    if (column->measured == 0)
+    {
+      column->measured = context->text_width(font, column->title, -1) + padding;
+    }
+    for (r = first; r < last; r++)
+    {
+      const char *text = src->cell(src->user, c, data_row(table, r), buffer, sizeof(buffer));
+      column->measured = mu_max(column->measured, context->text_width(font, text, -1) + padding);
+    }
+  }
+}
+
+static int column_width(mu_Table *table, int c)
+{
+  mu_TableColumn *column = &table->columns[c];
+  return column->width > 0 ? column->width : column->measured;
+}
+
+int mu_table_ex(mu_Context *context, mu_Table *table, int opt)
+{
+  mu_Style *style = context->style;
+  mu_TableSource *src = &table->source;
+  int row_height = style->size.y + style->padding * 2;
+  int text_height = context->text_height(style->font);
+  int width = 0, res = 0, first, last, header_y, c, r, x;
+  char buffer[MU_TABLE_CELL_SIZE];
+  mu_Rectangle area, clip, body;
+
+  if (table->column_count == 0)
+  {
+    return res;
+  }
+
+  /* reserve the full table so the container can scroll to every cell; the
+  ** widths come from the cache and catch up with new measurements next frame */
+  for (c = 0; c < table->column_count; c++)
+  {
+    width += column_width(table, c);
+  }
+  mu_layout_row(context, 1, &width, (table->row_count + 1) * row_height);
+  area = mu_layout_next(context);
+  clip = mu_get_clip_rect(context);
+  first = mu_max(0, (clip.y - area.y - row_height) / row_height);
+  last = mu_min(table->row_count, (clip.y + clip.h - area.y) / row_height);
+  measure_columns(context, table, first, mu_max(first, last));
+
+  /* the header sticks to the top of the clip rect while rows scroll under it */
+  header_y = mu_min(mu_max(area.y, clip.y), area.y + area.h - row_height);
+  body = mu_rect(area.x, header_y + row_height, area.w, area.y + area.h - header_y - row_height);
+  mu_push_clip_rect(context, body);
+
+  /* rows: one control per visible row for hover and selection */
+  for (r = first; r < last; r++)
+  {
+    int data = data_row(table, r);
+    mu_Identifier identifier = mu_get_id(context, &data, sizeof(data));
+    mu_Rectangle rect = mu_rect(area.x, area.y + (r + 1) * row_height, area.w, row_height);
+    mu_update_control(context, identifier, rect, opt);
+    if (context->mouse_pressed == MU_MOUSE_LEFT && context->focus == identifier &&
+        table->selected != data)
+    {
+      table->selected = data;
+      res |= MU_RES_CHANGE;
+    }
+    if (table->selected == data)
+    {
+      context->draw_frame(context, rect, MU_COLOR_BUTTONFOCUS);
+    }
+    else if (context->hover == identifier)
+    {
+      context->draw_frame(context, rect, MU_COLOR_BUTTONHOVER);
+    }
+  }
+
+  /* cells: column by column so each column's data is read sequentially */
+  for (c = 0, x = area.x; c < table->column_count; x += column_width(table, c++))
+  {
+    int w = column_width(table, c);
+    if (x + w <= clip.x || x >= clip.x + clip.w)
+    {
+      continue;
+    }
+    mu_push_clip_rect(context, mu_rect(x, body.y, w - style->spacing, body.h));
+    for (r = first; r < last; r++)
+    {
+      const char *text = src->cell(src->user, c, data_row(table, r), buffer, sizeof(buffer));
+      mu_Vector2 position = mu_vec2(x + style->padding,
+                                    area.y + (r + 1) * row_height + (row_height - text_height) / 2);
+      mu_draw_text(context, style->font, text, -1, position, style->colors[MU_COLOR_TEXT]);
+    }
+    mu_pop_clip_rect(context);
+  }
+  mu_pop_clip_rect(context);
+
+  /* header: clicking sorts by the column, clicking again reverses */
+  for (c = 0, x = area.x; c < table->column_count; x += column_width(table, c++))
+  {
+    mu_TableColumn *column = &table->columns[c];
+    mu_Identifier identifier = mu_get_id(context, &column, sizeof(column));
+    mu_Rectangle rect = mu_rect(x, header_y, column_width(table, c) - style->spacing, row_height);
+    int sortable = table->order && src->compare;
+    mu_update_control(context, identifier, rect, sortable ? opt : opt | MU_OPT_NOINTERACT);
+    if (context->mouse_pressed == MU_MOUSE_LEFT && context->focus == identifier)
+    {
+      mu_table_sort(table, c, table->sort_column == c && !table->sort_descending);
+      res |= MU_RES_CHANGE;
+    }
+    mu_draw_control_frame(context, identifier, rect, MU_COLOR_BUTTON, opt);
+    if (table->sort_column == c)
+    {
+      mu_Rectangle icon = mu_rect(rect.x + rect.w - row_height, rect.y, row_height, row_height);
+      mu_draw_icon(context, table->sort_descending ? MU_ICON_EXPANDED : MU_ICON_COLLAPSED,
+                   icon, style->colors[MU_COLOR_TEXT]);
+      rect.w -= row_height;
+    }
+    mu_draw_control_text(context, column->title, rect, MU_COLOR_TEXT, 0);
+  }
+
+  return res;
+}
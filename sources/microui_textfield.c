@@ -0,0 +1,341 @@
+/**
+ * @file microui_textfield.c
+ * @brief Implementation of the single-line text field
+ *
+ * `widths[i]` is the width of the first i bytes, with bytes inside a utf-8
+ * sequence sharing the width of the sequence start. Widths are summed per
+ * character, so an edit only measures the inserted characters and shifts
+ * the measured tail by the change in width. Anything not yet measured is
+ * filled in lazily, only as far as the caret or the right edge of the
+ * field needs it.
+ */
+
+#include <string.h>
+
+#include "microui_textfield.h"
+
+/*============================================================================
+** prefix widths
+**============================================================================*/
+
+static int next_char(const char *text, int pos, int length)
+{
+  if (pos >= length)
+  {
+    return length;
+  }
+  /* skip utf-8 continuation bytes */
+  while (++pos < length && (text[pos] & 0xc0) == 0x80)
+    ;
+  return pos;
+}
+
+static int prev_char(const char *text, int pos)
+{
+  /* skip utf-8 continuation bytes */
+  while (pos > 0 && (text[--pos] & 0xc0) == 0x80)
+    ;
+  return pos;
+}
+
+/* fill out[0, length) with the widths of the prefixes of text, starting at
+** x, and return the width of the whole text */
+static int measure(mu_Context *context, const char *text, int length, int x, int *out)
+{
+  int i = 0;
+  while (i < length)
+  {
+    int start = i, next = next_char(text, i, length);
+    for (; i < next; i++)
+    {
+      out[i] = x;
+    }
+    x += context->text_width(context->style->font, text + start, next - start);
+  }
+  return x;
+}
+
+/* extend the valid widths one character at a time until `pos` is covered
+** or the last one reaches past `x` */
+static void measure_until(mu_Context *context, mu_TextField *field, int pos, int x)
+{
+  int last;
+  if (field->font != context->style->font)
+  {
+    field->font = context->style->font;
+    field->measured = 1;
+  }
+  /* resume from the last character boundary known to be valid */
+  last = field->measured - 1;
+  while (last > 0 && (field->buffer[last] & 0xc0) == 0x80)
+  {
+    last--;
+  }
+  while (last < field->length && (last < pos || field->widths[last] <= x))
+  {
+    int next = next_char(field->buffer, last, field->length);
+    field->widths[next] = measure(context, field->buffer + last, next - last, field->widths[last],
+                                  field->widths + last);
+    last = next;
+  }
+  field->measured = mu_max(field->measured, last + 1);
+}
+
+/*============================================================================
+** editing
+**============================================================================*/
+
+/* replace bytes [start, end) with text; with a context the tail widths are
+** shifted instead of dropped */
+static int replace(mu_Context *context, mu_TextField *field, int start, int end, const char *text, int length)
+{
+  int delta = length - (end - start), i;
+  if (field->length + delta > field->size - 1)
+  {
+    return 0;
+  }
+  memmove(field->buffer + start + length, field->buffer + end, field->length - end + 1);
+  memcpy(field->buffer + start, text, length);
+  field->length += delta;
+
+  if (context && field->font == context->style->font && field->measured > end)
+  {
+    int base = field->widths[start], old_end = field->widths[end], x;
+    memmove(field->widths + start + length, field->widths + end, (field->measured - end) * sizeof(int));
+    field->measured += delta;
+    x = measure(context, text, length, base, field->widths + start);
+    for (i = start + length; i < field->measured; i++)
+    {
+      field->widths[i] += x - old_end;
+    }
+  }
+  else
+  {
+    field->measured = mu_min(field->measured, start + 1);
+  }
+  return 1;
+}
+
+void mu_textfield_init(mu_TextField *field, char *buffer, int size, int *widths)
+{
+  memset(field, 0, sizeof(*field));
+  field->buffer = buffer;
+  field->size = size;
+  field->widths = widths;
+  field->measured = 1;
+  buffer[0] = '\0';
+  widths[0] = 0;
+}
+
+void mu_textfield_set_text(mu_TextField *field, const char *text, int length)
+{
+  if (length < 0)
+  {
+    length = strlen(text);
+  }
+  /* truncate on a character boundary */
+  if (length > field->size - 1)
+  {
+    length = field->size - 1;
+    while (length > 0 && (text[length] & 0xc0) == 0x80)
+    {
+      length--;
+    }
+  }
+  replace(NULL, field, 0, field->length, text, length);
+  field->caret = field->anchor = field->length;
+}
+
+static int insert(mu_Context *context, mu_TextField *field, const char *text, int length)
+{
+  int start = mu_min(field->caret, field->anchor);
+  int end = mu_max(field->caret, field->anchor);
+  if (length < 0)
+  {
+    length = strlen(text);
+  }
+  if (!replace(context, field, start, end, text, length))
+  {
+    return 0;
+  }
+  field->caret = field->anchor = start + length;
+  return 1;
+}
+
+int mu_textfield_insert(mu_TextField *field, const char *text, int length)
+{
+  return insert(NULL, field, text, length);
+}
+
+/*============================================================================
+** widget
+**============================================================================*/
+
+/* last character start at or before x */
+static int floor_at_x(mu_Context *context, mu_TextField *field, int x)
+{
+  int low = 0, high;
+  measure_until(context, field, 0, x);
+  high = field->measured - 1;
+  while (low < high)
+  {
+    int mid = (low + high + 1) / 2;
+    if (field->widths[mid] <= x)
+    {
+      low = mid;
+    }
+    else
+    {
+      high = mid - 1;
+    }
+  }
+  /* bytes inside a sequence share its width, so low is past its start */
+  while (low > 0 && (field->buffer[low] & 0xc0) == 0x80)
+  {
+    low--;
+  }
+  return low;
+}
+
+/* character boundary closest to x */
+static int pos_at_x(mu_Context *context, mu_TextField *field, int x)
+{
+  int pos = floor_at_x(context, field, x);
+  int next = next_char(field->buffer, pos, field->length);
+  if (next < field->measured && x - field->widths[pos] > field->widths[next] - x)
+  {
+    return next;
+  }
+  return pos;
+}
+
+static void move_caret(mu_Context *context, mu_TextField *field, int pos)
+{
+  field->caret = pos;
+  if (!(context->key_down & MU_KEY_SHIFT))
+  {
+    field->anchor = pos;
+  }
+}
+
+static int handle_keys(mu_Context *context, mu_TextField *field)
+{
+  int key = context->key_pressed, shift = context->key_down & MU_KEY_SHIFT, res = 0;
+  int start, end;
+
+  /* editing */
+  if (context->input_text[0])
+  {
+    res |= insert(context, field, context->input_text, -1) ? MU_RES_CHANGE : 0;
+  }
+  start = mu_min(field->caret, field->anchor);
+  end = mu_max(field->caret, field->anchor);
+  if (key & (MU_KEY_BACKSPACE | MU_KEY_DELETE))
+  {
+    if (start == end)
+    {
+      start = key & MU_KEY_BACKSPACE ? prev_char(field->buffer, start) : start;
+      end = key & MU_KEY_DELETE ? next_char(field->buffer, end, field->length) : end;
+    }
+    if (start < end && replace(context, field, start, end, "", 0))
+    {
+      field->caret = field->anchor = start;
+      res |= MU_RES_CHANGE;
+    }
+  }
+  if (key & MU_KEY_RETURN)
+  {
+    mu_set_focus(context, 0);
+    res |= MU_RES_SUBMIT;
+  }
+
+  /* navigation: without shift, left and right collapse a selection */
+  start = mu_min(field->caret, field->anchor);
+  end = mu_max(field->caret, field->anchor);
+  if (key & MU_KEY_LEFT)
+  {
+    move_caret(context, field, start < end && !shift ? start : prev_char(field->buffer, field->caret));
+  }
+  if (key & MU_KEY_RIGHT)
+  {
+    move_caret(context, field,
+               start < end && !shift ? end : next_char(field->buffer, field->caret, field->length));
+  }
+  if (key & MU_KEY_HOME)
+  {
+    move_caret(context, field, 0);
+  }
+  if (key & MU_KEY_END)
+  {
+    move_caret(context, field, field->length);
+  }
+  return res;
+}
+
+int mu_textfield_ex(mu_Context *context, mu_TextField *field, int opt)
+{
+  mu_Style *style = context->style;
+  mu_Identifier identifier = mu_get_id(context, &field, sizeof(field));
+  mu_Rectangle area = mu_layout_next(context);
+  mu_Color color = style->colors[MU_COLOR_TEXT];
+  int inner = mu_max(area.w - style->padding * 2, 1);
+  int text_height = context->text_height(style->font);
+  int textx = area.x + style->padding, texty = area.y + (area.h - text_height) / 2;
+  int res = 0, first, last, start, end;
+  mu_update_control(context, identifier, area, opt | MU_OPT_HOLDFOCUS);
+
+  if (context->focus == identifier)
+  {
+    /* mouse: click places the caret (shift extends), drag selects */
+    if (context->mouse_down & MU_MOUSE_LEFT)
+    {
+      field->caret = pos_at_x(context, field, context->mouse_pos.x - textx + field->scroll);
+      if (context->mouse_pressed & MU_MOUSE_LEFT && !(context->key_down & MU_KEY_SHIFT))
+      {
+        field->anchor = field->caret;
+      }
+    }
+    res |= handle_keys(context, field);
+
+    /* keep the caret in view */
+    measure_until(context, field, field->caret, -1);
+    field->scroll = mu_clamp(field->scroll, field->widths[field->caret] + 1 - inner,
+                             field->widths[field->caret]);
+  }
+
+  /* no empty space after the end of the text, once the end is known */
+  measure_until(context, field, 0, field->scroll + inner);
+  if (field->measured > field->length)
+  {
+    field->scroll = mu_min(field->scroll, field->widths[field->length] + 1 - inner);
+  }
+  field->scroll = mu_max(field->scroll, 0);
+
+  /* draw only the characters overlapping the field */
+  mu_draw_control_frame(context, identifier, area, MU_COLOR_BASE, opt);
+  first = floor_at_x(context, field, field->scroll);
+  last = next_char(field->buffer, floor_at_x(context, field, field->scroll + inner), field->length);
+  start = mu_clamp(mu_min(field->caret, field->anchor), first, last);
+  end = mu_clamp(mu_max(field->caret, field->anchor), first, last);
+  mu_push_clip_rect(context, area);
+  if (start < end && context->focus == identifier)
+  {
+    mu_draw_rect(context,
+                 mu_rect(textx + field->widths[start] - field->scroll, texty,
+                         field->widths[end] - field->widths[start], text_height),
+                 style->colors[MU_COLOR_BUTTONHOVER]);
+  }
+  if (first < last)
+  {
+    mu_draw_text(context, style->font, field->buffer + first, last - first,
+                 mu_vec2(textx + field->widths[first] - field->scroll, texty), color);
+  }
+  if (context->focus == identifier)
+  {
+    mu_draw_rect(context, mu_rect(textx + field->widths[field->caret] - field->scroll, texty, 1, text_height),
+                 color);
+  }
+  mu_pop_clip_rect(context);
+
+  return res;
+}
@@ -0,0 +1,255 @@
+/**
+ * @file microui_tree.c
+ * @brief Implementation of the virtualized tree view
+ *
+ * The expansion set is a linear-probing hash table using backward-shift
+ * deletion, so collapsing never leaves tombstones behind. Visible rows are
+ * kept in depth-first order; a node's visible subtree is therefore always
+ * the contiguous run of deeper rows that follows it.
+ */
+
+#include <string.h>
+
+#include "microui_tree.h"
+
+/*============================================================================
+** expansion set
+**============================================================================*/
+
+static int home_slot(mu_Tree *tree, mu_TreeKey key)
+{
+  /* fibonacci hashing spreads sequential keys across the table */
+  return (int)((key * 0x9E3779B97F4A7C15ull) >> 32) & (tree->expanded_capacity - 1);
+}
+
+static int set_find(mu_Tree *tree, mu_TreeKey key)
+{
+  int mask = tree->expanded_capacity - 1;
+  int i = home_slot(tree, key);
+  while (tree->expanded[i])
+  {
+    if (tree->expanded[i] == key)
+    {
+      return i;
+    }
+    i = (i + 1) & mask;
+  }
+  return -1;
+}
+
+static int set_insert(mu_Tree *tree, mu_TreeKey key)
+{
+  int mask = tree->expanded_capacity - 1;
+  int i;
+  /* keep the load factor under 3/4 so probes stay short */
+  if ((tree->expanded_count + 1) * 4 > tree->expanded_capacity * 3)
+  {
+    return 0;
+  }
+  i = home_slot(tree, key);
+  while (tree->expanded[i])
+  {
+    if (tree->expanded[i] == key)
+    {
+      return 1;
+    }
+    i = (i + 1) & mask;
+  }
+  tree->expanded[i] = key;
+  tree->expanded_count++;
+  return 1;
+}
+
+static void set_remove(mu_Tree *tree, mu_TreeKey key)
+{
+  int mask = tree->expanded_capacity - 1;
+  int i = set_find(tree, key), j;
+  if (i < 0)
+  {
+    return;
+  }
+  /* shift later members of the probe run back into the hole */
+  for (j = (i + 1) & mask; tree->expanded[j]; j = (j + 1) & mask)
+  {
+    int k = home_slot(tree, tree->expanded[j]);
+    if ((j > i && (k <= i || k > j)) || (j < i && k <= i && k > j))
+    {
+      tree->expanded[i] = tree->expanded[j];
+      i = j;
+    }
+  }
+  tree->expanded[i] = 0;
+  tree->expanded_count--;
+}
+
+int mu_tree_is_expanded(mu_Tree *tree, mu_TreeKey key)
+{
+  return set_find(tree, key) >= 0;
+}
+
+/*============================================================================
+** rows
+**============================================================================*/
+
+static int count_subtree(mu_Tree *tree, mu_TreeKey key)
+{
+  mu_TreeSource *src = &tree->source;
+  int i, n = src->child_count(src->user, key), total = n;
+  for (i = 0; i < n; i++)
+  {
+    mu_TreeKey child = src->child(src->user, key, i);
+    if (mu_tree_is_expanded(tree, child))
+    {
+      total += count_subtree(tree, child);
+    }
+  }
+  return total;
+}
+
+static void fill_subtree(mu_Tree *tree, mu_TreeKey key, int depth, int *pos, int end)
+{
+  mu_TreeSource *src = &tree->source;
+  int i, n = src->child_count(src->user, key);
+  for (i = 0; i < n && *pos < end; i++)
+  {
+    mu_TreeKey child = src->child(src->user, key, i);
+    tree->rows[*pos].key = child;
+    tree->rows[*pos].depth = depth;
+    (*pos)++;
+    if (mu_tree_is_expanded(tree, child))
+    {
+      fill_subtree(tree, child, depth + 1, pos, end);
+    }
+  }
+}
+
+void mu_tree_init(mu_Tree *tree, mu_TreeSource source, mu_TreeKey root,
+                  mu_TreeKey *expanded, int expanded_capacity,
+                  mu_TreeRow *rows, int row_capacity)
+{
+  memset(tree, 0, sizeof(*tree));
+  tree->source = source;
+  tree->root = root;
+  tree->expanded = expanded;
+  tree->expanded_capacity = expanded_capacity;
+  tree->rows = rows;
+  tree->row_capacity = row_capacity;
+  memset(expanded, 0, expanded_capacity * sizeof(*expanded));
+  mu_tree_rebuild(tree);
+}
+
+void mu_tree_rebuild(mu_Tree *tree)
+{
+  tree->row_count = 0;
+  fill_subtree(tree, tree->root, 0, &tree->row_count, tree->row_capacity);
+}
+
+static int expand_row(mu_Tree *tree, int row)
+{
+  mu_TreeKey key = tree->rows[row].key;
+  int n = count_subtree(tree, key);
+  int pos = row + 1;
+  if (tree->row_count + n > tree->row_capacity || !set_insert(tree, key))
+  {
+    return 0;
+  }
+  /* open a gap after the row and flatten the subtree into it */
+  memmove(tree->rows + pos + n, tree->rows + pos,
+          (tree->row_count - pos) * sizeof(*tree->rows));
+  fill_subtree(tree, key, tree->rows[row].depth + 1, &pos, row + 1 + n);
+  tree->row_count += n;
+  return 1;
+}
+
+static void collapse_row(mu_Tree *tree, int row)
+{
+  int depth = tree->rows[row].depth;
+  int end = row + 1;
+  while (end < tree->row_count && tree->rows[end].depth > depth)
+  {
+    end++;
+  }
+  memmove(tree->rows + row + 1, tree->rows + end,
+          (tree->row_count - end) * sizeof(*tree->rows));
+  tree->row_count -= end - row - 1;
+  set_remove(tree, tree->rows[row].key);
+}
+
+int mu_tree_toggle(mu_Tree *tree, int row)
+{
+  if (row < 0 || row >= tree->row_count)
+  {
+    return 0;
+  }
+  if (mu_tree_is_expanded(tree, tree->rows[row].key))
+  {
+    collapse_row(tree, row);
+    return 1;
+  }
+  return expand_row(tree, row);
+}
+
+/*============================================================================
+** widget
+**============================================================================*/
+
+int mu_tree_ex(mu_Context *context, mu_Tree *tree, int opt)
+{
+  mu_Style *style = context->style;
+  mu_TreeSource *src = &tree->source;
+  int row_height = style->size.y + style->padding * 2;
+  int res = 0, first, last, r;
+  mu_Rectangle area;
+
+  if (tree->row_count == 0)
+  {
+    return res;
+  }
+
+  area = mu_layout_rows(context, tree->row_count, row_height, &first, &last);
+
+  for (r = first; r < last && r < tree->row_count; r++)
+  {
+    mu_TreeKey key = tree->rows[r].key;
+    mu_Identifier identifier = mu_get_id(context, &key, sizeof(key));
+    mu_Rectangle rect = mu_rect(area.x, area.y + r * row_height, area.w, row_height);
+    mu_Rectangle arrow = mu_rect(rect.x + tree->rows[r].depth * style->indentation,
+                                 rect.y, row_height, row_height);
+    int has_children = src->child_count(src->user, key) > 0;
+    mu_update_control(context, identifier, rect, opt);
+
+    /* handle click: the arrow toggles, the rest of the row selects */
+    if (context->mouse_pressed == MU_MOUSE_LEFT && context->focus == identifier)
+    {
+      if (has_children && mu_mouse_over(context, arrow))
+      {
+        res |= mu_tree_toggle(tree, r) ? MU_RES_CHANGE : 0;
+      }
+      else if (tree->selected != key)
+      {
+        tree->selected = key;
+        res |= MU_RES_CHANGE;
+      }
+    }
+
+    /* draw */
+    if (tree->selected == key)
+    {
+      context->draw_frame(context, rect, MU_COLOR_BUTTONFOCUS);
+    }
+    else if (context->hover == identifier)
+    {
+      context->draw_frame(context, rect, MU_COLOR_BUTTONHOVER);
+    }
+    if (has_children)
+    {
+      mu_draw_icon(context, mu_tree_is_expanded(tree, key) ? MU_ICON_EXPANDED : MU_ICON_COLLAPSED,
+                   arrow, style->colors[MU_COLOR_TEXT]);
+    }
+    rect.x = arrow.x + arrow.w - style->padding;
+    rect.w = area.x + area.w - rect.x;
+    mu_draw_control_text(context, src->label(src->user, key), rect, MU_COLOR_TEXT, 0);
+  }
+
+  return res;
+}